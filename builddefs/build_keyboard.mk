@@ -257,6 +257,17 @@ $(INTERMEDIATE_OUTPUT)/src/keymap.h: $(KEYMAP_JSON) $(DD_CONFIG_FILES)
 
 generated-files: $(INTERMEDIATE_OUTPUT)/src/config.h $(INTERMEDIATE_OUTPUT)/src/keymap.c $(INTERMEDIATE_OUTPUT)/src/keymap.h
 
+$(INTERMEDIATE_OUTPUT)/src/keycode_actions.h: $(KEYMAP_JSON) $(DD_CONFIG_FILES)
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=$(QMK_BIN) generate-keycode-actions-h --quiet --output $(INTERMEDIATE_OUTPUT)/src/keycode_actions.h $(KEYMAP_JSON))
+	@$(BUILD_CMD)
+
+ifeq ($(strip $(KEYCODE_ACTION_TABLE_ENABLE)), yes)
+generated-files: $(INTERMEDIATE_OUTPUT)/src/keycode_actions.h
+endif
+
+else ifeq ($(strip $(KEYCODE_ACTION_TABLE_ENABLE)), yes)
+    $(call CATASTROPHIC_ERROR,Invalid keymap,KEYCODE_ACTION_TABLE_ENABLE requires a keymap.json)
 endif
 
 # Community modules
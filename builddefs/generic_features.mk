@@ -34,6 +34,7 @@ GENERIC_FEATURES = \
     DYNAMIC_TAPPING_TERM \
     GRAVE_ESC \
     HAPTIC \
+    KEYCODE_ACTION_TABLE \
     KEY_LOCK \
     KEY_OVERRIDE \
     LAYER_LOCK \
@@ -44,6 +45,7 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    SCAN_PROFILER \
     SECURE \
     SEND_STRING \
     SEQUENCER \
@@ -6,6 +6,22 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef WEAR_LEVELING_WRITE_CACHE
+#    include "timer.h"
+
+#    ifndef WEAR_LEVELING_WRITE_CACHE_IDLE_TIMEOUT
+#        define WEAR_LEVELING_WRITE_CACHE_IDLE_TIMEOUT 500
+#    endif // WEAR_LEVELING_WRITE_CACHE_IDLE_TIMEOUT
+
+#    ifndef WEAR_LEVELING_WRITE_CACHE_TIMEOUT
+#        define WEAR_LEVELING_WRITE_CACHE_TIMEOUT 5000
+#    endif // WEAR_LEVELING_WRITE_CACHE_TIMEOUT
+
+static bool     write_pending = false;
+static uint32_t first_write_time;
+static uint32_t last_write_time;
+#endif // WEAR_LEVELING_WRITE_CACHE
+
 void eeprom_driver_init(void) {
     wear_leveling_init();
 }
@@ -21,9 +37,36 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    wear_leveling_read((uint32_t)addr, buf, len);
+    wear_leveling_read((uint32_t)(uintptr_t)addr, buf, len);
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    wear_leveling_write((uint32_t)addr, buf, len);
+    wear_leveling_write((uint32_t)(uintptr_t)addr, buf, len);
+#ifdef WEAR_LEVELING_WRITE_CACHE
+    last_write_time = timer_read32();
+    if (!write_pending) {
+        write_pending    = true;
+        first_write_time = last_write_time;
+    }
+#endif // WEAR_LEVELING_WRITE_CACHE
+}
+
+#ifdef WEAR_LEVELING_WRITE_CACHE
+void eeprom_driver_flush(void) {
+    if (wear_leveling_flush() != WEAR_LEVELING_FAILED) {
+        write_pending = false;
+        return;
+    }
+    // Whatever could not be written is still dirty in the cache, so try again once the idle timeout has passed
+    write_pending    = true;
+    last_write_time  = timer_read32();
+    first_write_time = last_write_time;
+}
+
+void eeprom_driver_task(void) {
+    // Flush once writes have stopped for a while, or have kept coming for too long
+    if (write_pending && (timer_elapsed32(last_write_time) >= WEAR_LEVELING_WRITE_CACHE_IDLE_TIMEOUT || timer_elapsed32(first_write_time) >= WEAR_LEVELING_WRITE_CACHE_TIMEOUT)) {
+        eeprom_driver_flush();
+    }
 }
+#endif // WEAR_LEVELING_WRITE_CACHE
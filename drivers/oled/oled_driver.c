@@ -31,6 +31,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "progmem.h"
 #include "wait.h"
 
+#if defined(OLED_ASYNC_RENDER)
+#    if !defined(PROTOCOL_CHIBIOS) || !defined(OLED_TRANSPORT_I2C)
+#        error "OLED_ASYNC_RENDER is only supported on ChibiOS with the I2C transport"
+#    endif
+#    include <ch.h>
+#    include <hal.h>
+#    if !defined(I2C_USE_MUTUAL_EXCLUSION) || I2C_USE_MUTUAL_EXCLUSION != TRUE
+#        error "OLED_ASYNC_RENDER requires I2C_USE_MUTUAL_EXCLUSION in halconf.h"
+#    endif
+
+static void oled_render_thread_init(void);
+#endif
+
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
 // for SH1107: https://www.displayfuture.com/Display/datasheet/controller/SH1107.pdf
@@ -253,6 +266,32 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
 #endif
 }
 
+#if defined(OLED_ASYNC_RENDER)
+// Held by the render thread across each block's addressing command and data, and by the main thread around its own
+// commands, so that neither can land in the middle of the other's sequence
+static MUTEX_DECL(oled_transfer_mutex);
+#    define oled_transfer_lock() chMtxLock(&oled_transfer_mutex)
+#    define oled_transfer_unlock() chMtxUnlock(&oled_transfer_mutex)
+#else
+#    define oled_transfer_lock()
+#    define oled_transfer_unlock()
+#endif
+
+// Sends a standalone command from the main thread
+static bool oled_command(const uint8_t *data, uint16_t size) {
+    oled_transfer_lock();
+    bool success = oled_send_cmd(data, size);
+    oled_transfer_unlock();
+    return success;
+}
+
+static bool oled_command_P(const uint8_t *data, uint16_t size) {
+    oled_transfer_lock();
+    bool success = oled_send_cmd_P(data, size);
+    oled_transfer_unlock();
+    return success;
+}
+
 __attribute__((weak)) void oled_driver_init(void) {
 #if defined(OLED_TRANSPORT_SPI)
     spi_init();
@@ -366,6 +405,9 @@ bool oled_init(oled_rotation_t rotation) {
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
+#if defined(OLED_ASYNC_RENDER)
+    oled_render_thread_init();
+#endif
     return true;
 }
 
@@ -446,6 +488,169 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+// Sends a single block of the given buffer to the display
+static bool oled_render_block(const uint8_t *buffer, uint8_t block) {
+    // Set column & page position
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+#else
+    static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+#endif
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        calc_bounds(block, &display_start[1]); // Offset from I2C_CMD byte at the start
+    } else {
+        calc_bounds_90(block, &display_start[1]); // Offset from I2C_CMD byte at the start
+    }
+
+    // Send column & page position
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        // Send render data chunk as is
+        if (!oled_send_data(&buffer[OLED_BLOCK_SIZE * block], OLED_BLOCK_SIZE)) {
+            print("oled_render data failed\n");
+            return false;
+        }
+    } else {
+        // Rotate the render chunks
+        const static uint8_t source_map[] = OLED_SOURCE_MAP;
+        const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+        memset(temp_buffer, 0, sizeof(temp_buffer));
+        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+            rotate_90(&buffer[OLED_BLOCK_SIZE * block + source_map[i]], &temp_buffer[target_map[i]]);
+        }
+
+#if OLED_IC_HAS_HORIZONTAL_MODE
+        // Send render data chunk after rotating
+        if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            print("oled_render90 data failed\n");
+            return false;
+        }
+#else
+        // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+        const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+        const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+        for (uint8_t i = 0; i < num_pages; ++i) {
+            // Send column & page position for all pages except the first one
+            if (i > 0) {
+                display_start[1]++;
+                if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    print("oled_render offset command failed\n");
+                    return false;
+                }
+            }
+            // Send data for the page
+            if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                print("oled_render90 data failed\n");
+                return false;
+            }
+        }
+#endif
+    }
+
+    return true;
+}
+
+#if defined(OLED_ASYNC_RENDER)
+// Snapshot of the blocks being sent by the render thread, so that drawing can carry on in oled_buffer meanwhile
+static uint8_t                  oled_render_buffer[OLED_MATRIX_SIZE];
+static volatile OLED_BLOCK_TYPE oled_render_blocks = 0;
+static BSEMAPHORE_DECL(oled_render_start, true);
+static BSEMAPHORE_DECL(oled_render_idle, false);
+// Room for the rotated block and the I2C driver's copy of it with the register address prepended, on top of the rest
+#    ifndef OLED_RENDER_THREAD_STACK_SIZE
+#        define OLED_RENDER_THREAD_STACK_SIZE (512 + 2 * (OLED_BLOCK_SIZE + 2))
+#    endif
+static THD_WORKING_AREA(waOledRenderThread, OLED_RENDER_THREAD_STACK_SIZE);
+// Above the main loop so that handing over blocks starts the transfer straight away, the thread mostly waits on I2C
+#    ifndef OLED_RENDER_THREAD_PRIORITY
+#        define OLED_RENDER_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+
+static THD_FUNCTION(OledRenderThread, arg) {
+    (void)arg;
+    chRegSetThreadName("oled_render");
+
+    while (true) {
+        chBSemWait(&oled_render_start);
+
+        for (uint8_t block = 0; block < OLED_BLOCK_COUNT && oled_render_blocks; block++) {
+            if (!(oled_render_blocks & ((OLED_BLOCK_TYPE)1 << block))) {
+                continue;
+            }
+            // Leave failed blocks flagged, they are merged back into oled_dirty on the next render
+            oled_transfer_lock();
+            bool success = oled_render_block(oled_render_buffer, block);
+            oled_transfer_unlock();
+            if (!success) {
+                break;
+            }
+            oled_render_blocks &= ~((OLED_BLOCK_TYPE)1 << block);
+        }
+
+        chBSemSignal(&oled_render_idle);
+    }
+}
+
+static bool oled_render_pending(void) {
+    return oled_render_blocks != 0;
+}
+
+static void oled_render_thread_init(void) {
+    static bool started = false;
+    if (!started) {
+        started = true;
+        chThdCreateStatic(waOledRenderThread, sizeof(waOledRenderThread), OLED_RENDER_THREAD_PRIORITY, OledRenderThread, NULL);
+    }
+}
+
+void oled_render_dirty(bool all) {
+    // Wait for the previous frame if everything must be rendered, otherwise try again on the next call
+    if (all) {
+        chBSemWait(&oled_render_idle);
+    } else if (chBSemWaitTimeout(&oled_render_idle, TIME_IMMEDIATE) != MSG_OK) {
+        return;
+    }
+    oled_dirty |= oled_render_blocks;
+    oled_render_blocks = 0;
+
+    // Do we have work to do?
+    oled_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_dirty || !oled_initialized || oled_scrolling) {
+        chBSemSignal(&oled_render_idle);
+        return;
+    }
+
+    // Turn on display if it is off
+    oled_on();
+
+    // Hand over all dirty blocks (up to the configured limit), the rest stay dirty for the next call
+    OLED_BLOCK_TYPE blocks        = 0;
+    uint8_t         num_processed = 0;
+    for (uint8_t block = 0; block < OLED_BLOCK_COUNT && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all); block++) {
+        if (oled_dirty & ((OLED_BLOCK_TYPE)1 << block)) {
+            memcpy(&oled_render_buffer[OLED_BLOCK_SIZE * block], &oled_buffer[OLED_BLOCK_SIZE * block], OLED_BLOCK_SIZE);
+            blocks |= (OLED_BLOCK_TYPE)1 << block;
+            num_processed++;
+        }
+    }
+    oled_render_blocks = blocks;
+    oled_dirty &= ~blocks;
+    chBSemSignal(&oled_render_start);
+
+    if (all) {
+        chBSemWait(&oled_render_idle);
+        chBSemSignal(&oled_render_idle);
+    }
+}
+#else
+#    define oled_render_pending() false
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
@@ -464,73 +669,15 @@ void oled_render_dirty(bool all) {
             ++update_start;
         }
 
-        // Set column & page position
-#if OLED_IC_HAS_HORIZONTAL_MODE
-        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-#else
-        static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
-#endif
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        }
-
-        // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-            print("oled_render offset command failed\n");
+        if (!oled_render_block(oled_buffer, update_start)) {
             return;
         }
 
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
-                return;
-            }
-        } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
-
-#if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
-            }
-#else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
-                    return;
-                }
-            }
-#endif
-        }
-
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
 }
+#endif // defined(OLED_ASYNC_RENDER)
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
     uint16_t index = line * oled_rotation_width + col * OLED_FONT_WIDTH;
@@ -749,7 +896,7 @@ bool oled_on(void) {
 #endif
 
     if (!oled_active) {
-        if (!oled_send_cmd_P(display_on, ARRAY_SIZE(display_on))) {
+        if (!oled_command_P(display_on, ARRAY_SIZE(display_on))) {
             print("oled_on cmd failed\n");
             return oled_active;
         }
@@ -771,7 +918,7 @@ bool oled_off(void) {
 #endif
 
     if (oled_active) {
-        if (!oled_send_cmd_P(display_off, ARRAY_SIZE(display_off))) {
+        if (!oled_command_P(display_off, ARRAY_SIZE(display_off))) {
             print("oled_off cmd failed\n");
             return oled_active;
         }
@@ -791,7 +938,7 @@ uint8_t oled_set_brightness(uint8_t level) {
 
     uint8_t set_contrast[] = {I2C_CMD, CONTRAST, level};
     if (oled_brightness != level) {
-        if (!oled_send_cmd(set_contrast, ARRAY_SIZE(set_contrast))) {
+        if (!oled_command(set_contrast, ARRAY_SIZE(set_contrast))) {
             print("set_brightness cmd failed\n");
             return oled_brightness;
         }
@@ -836,9 +983,9 @@ bool oled_scroll_right(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_dirty && !oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_right[] = {I2C_CMD, SCROLL_RIGHT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
-        if (!oled_send_cmd(display_scroll_right, ARRAY_SIZE(display_scroll_right))) {
+        if (!oled_command(display_scroll_right, ARRAY_SIZE(display_scroll_right))) {
             print("oled_scroll_right cmd failed\n");
             return oled_scrolling;
         }
@@ -854,9 +1001,9 @@ bool oled_scroll_left(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_dirty && !oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_left[] = {I2C_CMD, SCROLL_LEFT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
-        if (!oled_send_cmd(display_scroll_left, ARRAY_SIZE(display_scroll_left))) {
+        if (!oled_command(display_scroll_left, ARRAY_SIZE(display_scroll_left))) {
             print("oled_scroll_left cmd failed\n");
             return oled_scrolling;
         }
@@ -872,7 +1019,7 @@ bool oled_scroll_off(void) {
 
     if (oled_scrolling) {
         static const uint8_t PROGMEM display_scroll_off[] = {I2C_CMD, DEACTIVATE_SCROLL};
-        if (!oled_send_cmd_P(display_scroll_off, ARRAY_SIZE(display_scroll_off))) {
+        if (!oled_command_P(display_scroll_off, ARRAY_SIZE(display_scroll_off))) {
             print("oled_scroll_off cmd failed\n");
             return oled_scrolling;
         }
@@ -893,14 +1040,14 @@ bool oled_invert(bool invert) {
 
     if (invert && !oled_inverted) {
         static const uint8_t PROGMEM display_inverted[] = {I2C_CMD, INVERT_DISPLAY};
-        if (!oled_send_cmd_P(display_inverted, ARRAY_SIZE(display_inverted))) {
+        if (!oled_command_P(display_inverted, ARRAY_SIZE(display_inverted))) {
             print("oled_invert cmd failed\n");
             return oled_inverted;
         }
         oled_inverted = true;
     } else if (!invert && oled_inverted) {
         static const uint8_t PROGMEM display_normal[] = {I2C_CMD, NORMAL_DISPLAY};
-        if (!oled_send_cmd_P(display_normal, ARRAY_SIZE(display_normal))) {
+        if (!oled_command_P(display_normal, ARRAY_SIZE(display_normal))) {
             print("oled_invert cmd failed\n");
             return oled_inverted;
         }
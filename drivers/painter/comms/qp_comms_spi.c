@@ -9,6 +9,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
+static bool qp_comms_spi_async_enabled = false;
+
 bool qp_comms_spi_init(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -37,7 +39,11 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
 
     while (bytes_remaining > 0) {
         uint32_t bytes_this_loop = QP_MIN(bytes_remaining, max_msg_length);
-        spi_transmit(p, bytes_this_loop);
+        if (qp_comms_spi_async_enabled) {
+            spi_transmit_async(p, bytes_this_loop);
+        } else {
+            spi_transmit(p, bytes_this_loop);
+        }
         p += bytes_this_loop;
         bytes_remaining -= bytes_this_loop;
     }
@@ -50,6 +56,15 @@ void qp_comms_spi_stop(painter_device_t device) {
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
     spi_stop();
     gpio_write_pin_high(comms_config->chip_select_pin);
+    qp_comms_spi_async_enabled = false;
+}
+
+bool qp_comms_spi_async(painter_device_t device, bool enable) {
+    if (!enable) {
+        spi_wait();
+    }
+    qp_comms_spi_async_enabled = enable;
+    return true;
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
@@ -57,6 +72,7 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+    .comms_async = qp_comms_spi_async,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -100,6 +116,7 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    spi_wait(); // any data still being sent must go out with D/C high
     gpio_write_pin_low(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -135,6 +152,7 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+            .comms_async = qp_comms_spi_async,
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -15,6 +15,14 @@
 #include "spi_master.h"
 #include "progmem.h"
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    include <ch.h>
+// Burst reads run on the sampling thread, which can sleep through tSRAD_MOTBR and let the main loop run meanwhile
+#    define pmw33xx_wait_burst() chThdSleepMicroseconds(35)
+#else
+#    define pmw33xx_wait_burst() wait_us(35)
+#endif
+
 extern const uint8_t pmw33xx_firmware_signature[2] PROGMEM;
 
 static const pin_t cs_pins_left[]  = PMW33XX_CS_PINS;
@@ -217,7 +225,7 @@ pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
     }
 
     spi_write(REG_Motion_Burst);
-    wait_us(35); // waits for tSRAD_MOTBR
+    pmw33xx_wait_burst(); // waits for tSRAD_MOTBR
 
     spi_receive((uint8_t *)&report, sizeof(report));
 
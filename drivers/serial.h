@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSACTION_ASYNC
+// starts a transaction in the background, returns false if one is still in progress
+bool soft_serial_transaction_start(int sstd_index);
+// returns true once a background transaction has completed, storing its outcome in success
+bool soft_serial_transaction_finished(bool *success);
+#endif // SPLIT_TRANSACTION_ASYNC
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -57,6 +57,7 @@ subcommands = [
     'qmk.cli.generate.info_json',
     'qmk.cli.generate.keyboard_c',
     'qmk.cli.generate.keyboard_h',
+    'qmk.cli.generate.keycode_actions',
     'qmk.cli.generate.keycodes',
     'qmk.cli.generate.keycodes_tests',
     'qmk.cli.generate.keymap_h',
@@ -18,6 +18,7 @@ def _gen_led_configs(info_data):
 
     if 'layout' in info_data.get('rgb_matrix', {}):
         lines.extend(_gen_led_config(info_data, 'rgb_matrix'))
+        lines.extend(_gen_led_tables(info_data))
 
     if 'layout' in info_data.get('led_matrix', {}):
         lines.extend(_gen_led_config(info_data, 'led_matrix'))
@@ -66,6 +67,96 @@ def _gen_led_config(info_data, config_type):
     return lines
 
 
+def _sqrt16(x):
+    """Bit-exact port of lib8tion's sqrt16().
+    """
+    x &= 0xFFFF
+    if x <= 1:
+        return x
+
+    low = 1
+    hi = 255 if x > 7904 else (x >> 5) + 8
+    while hi >= low:
+        mid = (low + hi) >> 1
+        if mid * mid > x:
+            hi = mid - 1
+        else:
+            if mid == 255:
+                return 255
+            low = mid + 1
+
+    return low - 1
+
+
+def _atan2_8(dy, dx):
+    """Bit-exact port of lib8tion's atan2_8().
+    """
+    def c_div(a, b):
+        q = abs(a) // abs(b)
+        return q if (a >= 0) == (b >= 0) else -q
+
+    if dy == 0:
+        return 0 if dx >= 0 else 128
+
+    abs_y = abs(dy)
+    if dx >= 0:
+        a = 32 - c_div(32 * (dx - abs_y), dx + abs_y)
+    else:
+        a = 96 - c_div(32 * (dx + abs_y), abs_y - dx)
+
+    if dy < 0:
+        a = -a
+    return a & 0xFF
+
+
+def _gen_led_tables(info_data):
+    """Precompute the per-LED polar coordinates and neighbour lists used by RGB Matrix effects
+    """
+    rgb_matrix = info_data['rgb_matrix']
+    center_x, center_y = rgb_matrix.get('center_point', [112, 32])
+    radius = rgb_matrix.get('neighbour_radius', 40)
+
+    points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in rgb_matrix['layout']]
+
+    polar = []
+    matrix_pos = []
+    for led_data, (x, y) in zip(rgb_matrix['layout'], points):
+        dx = x - center_x
+        dy = y - center_y
+        polar.append(f'{{{_sqrt16(dx * dx + dy * dy)}, {_atan2_8(dy, dx)}}}')
+        row, col = led_data.get('matrix', [255, 255])
+        matrix_pos.append(f'{{{col}, {row}}}')
+
+    offsets = [0]
+    neighbours = []
+    for index, (x, y) in enumerate(points):
+        found = []
+        for other, (other_x, other_y) in enumerate(points):
+            if other == index:
+                continue
+            dist = _sqrt16((x - other_x)**2 + (y - other_y)**2)
+            if dist <= radius:
+                found.append((dist, other))
+
+        # Sorted by distance so that effects can stop at the first neighbour out of reach
+        neighbours.extend(f'{{{other}, {dist}}}' for dist, other in sorted(found))
+        offsets.append(len(neighbours))
+
+    if not neighbours:
+        neighbours.append('{NO_LED, 0}')
+
+    lines = []
+    lines.append('#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_LED_TABLES)')
+    lines.append(f'const led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT] PROGMEM = {{ {", ".join(polar)} }};')
+    lines.append(f'const keypos_t g_led_matrix_pos[RGB_MATRIX_LED_COUNT] PROGMEM = {{ {", ".join(matrix_pos)} }};')
+    lines.append(f'const uint16_t g_led_neighbour_offsets[RGB_MATRIX_LED_COUNT + 1] PROGMEM = {{ {", ".join(map(str, offsets))} }};')
+    lines.append(f'const led_neighbour_t g_led_neighbours[] PROGMEM = {{ {", ".join(neighbours)} }};')
+    lines.append('#endif')
+    lines.append('')
+
+    return lines
+
+
 def _gen_matrix_mask(info_data):
     """Convert info.json content to matrix_mask
     """
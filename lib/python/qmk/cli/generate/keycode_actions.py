@@ -0,0 +1,72 @@
+"""Used by the make system to generate keycode_actions.h from keymap.json
+"""
+from argcomplete.completers import FilesCompleter
+
+from milc import cli
+
+import qmk.path
+from qmk.commands import dump_lines
+from qmk.commands import parse_configurator_json
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+
+# Keycodes that never need an entry, as they resolve to ACTION_NO anyway
+IGNORED_KEYCODES = ('KC_NO', 'XXXXXXX')
+
+
+def _strip_any(keycode):
+    """Remove ANY() from a keycode.
+    """
+    keycode = keycode.strip()
+    if keycode.startswith('ANY(') and keycode.endswith(')'):
+        keycode = keycode[4:-1]
+    return keycode
+
+
+def _keymap_keycodes(keymap_json):
+    """Returns the distinct keycodes used by the layers and encoder map of a keymap, in order of first use.
+    """
+    keycodes = []
+
+    for layer in keymap_json.get('layers') or []:
+        keycodes.extend(layer)
+
+    for layer in keymap_json.get('encoders') or []:
+        for encoder in layer:
+            keycodes.extend([encoder['ccw'], encoder['cw']])
+
+    keycodes = [_strip_any(keycode) for keycode in keycodes]
+
+    return list(dict.fromkeys(keycode for keycode in keycodes if keycode and keycode not in IGNORED_KEYCODES))
+
+
+def _table_size(keycode_count):
+    """Returns the smallest power of two that keeps the table at most half full.
+    """
+    size = 8
+    while size < keycode_count * 2:
+        size *= 2
+    return size
+
+
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('filename', type=qmk.path.FileType('r'), arg_only=True, completer=FilesCompleter('.json'), help='Configurator JSON file')
+@cli.subcommand('Used by the make system to generate keycode_actions.h from keymap.json', hidden=True)
+def generate_keycode_actions_h(cli):
+    """Creates a keycode_actions.h from a QMK Configurator export
+    """
+    if cli.args.output and cli.args.output.name == '-':
+        cli.args.output = None
+
+    keymap_json = parse_configurator_json(cli.args.filename)
+    keycodes = _keymap_keycodes(keymap_json)
+
+    lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '// clang-format off', '']
+    lines.append(f'#define KEYCODE_ACTION_TABLE_SIZE {_table_size(len(keycodes))}')
+    lines.append('')
+    lines.append('#define KEYCODE_ACTION_TABLE_KEYCODES \\')
+    for keycode in keycodes:
+        lines.append(f'    {keycode}, \\')
+    lines.append('')
+
+    dump_lines(cli.args.output, lines, cli.args.quiet)
@@ -311,6 +311,13 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_keycode_actions_h():
+    result = check_subcommand('generate-keycode-actions-h', 'keyboards/handwired/pytest/basic/keymaps/default_json/keymap.json')
+    check_returncode(result)
+    assert '#define KEYCODE_ACTION_TABLE_SIZE 8' in result.stdout
+    assert '    KC_A, \\' in result.stdout
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
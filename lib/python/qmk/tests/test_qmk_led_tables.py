@@ -0,0 +1,91 @@
+import math
+
+from qmk.cli.generate.keyboard_c import _atan2_8, _gen_led_tables, _sqrt16
+
+
+def test_sqrt16_matches_integer_sqrt():
+    for x in range(0x10000):
+        assert _sqrt16(x) == math.isqrt(x)
+
+
+def test_sqrt16_truncates_to_16_bits():
+    assert _sqrt16(0x10000 + 100) == 10
+
+
+def test_atan2_8_axes():
+    assert _atan2_8(0, 1) == 0
+    assert _atan2_8(1, 0) == 64
+    assert _atan2_8(0, -1) == 128
+    assert _atan2_8(-1, 0) == 192
+    assert _atan2_8(1, 1) == 32
+    assert _atan2_8(-1, -1) == 160
+
+
+def test_atan2_8_matches_lib8tion():
+    # (dy, dx, atan2_8(dy, dx)) as returned by lib8tion on the keyboard
+    expected = [
+        (-224, -214, 160),
+        (-217, -179, 163),
+        (-210, -144, 165),
+        (-203, -109, 169),
+        (-196, -74, 174),
+        (-189, -39, 181),
+        (-182, -4, 190),
+        (-175, 31, 202),
+        (-168, 66, 211),
+        (-161, 101, 217),
+        (-154, 136, 223),
+        (-147, 171, 226),
+    ]
+    for dy, dx, angle in expected:
+        assert _atan2_8(dy, dx) == angle
+
+
+def test_atan2_8_close_to_atan2():
+    for dy in range(-64, 65, 3):
+        for dx in range(-224, 225, 7):
+            if dx == 0 and dy == 0:
+                continue
+            exact = math.atan2(dy, dx) * 128 / math.pi
+            error = (_atan2_8(dy, dx) - exact + 128) % 256 - 128
+            assert abs(error) < 4
+
+
+def test_gen_led_tables():
+    info_data = {
+        'rgb_matrix': {
+            'center_point': [10, 10],
+            'neighbour_radius': 25,
+            'layout': [
+                {'matrix': [0, 0], 'x': 10, 'y': 10},
+                {'matrix': [0, 1], 'x': 30, 'y': 10},
+                {'x': 10, 'y': 0},
+                {'matrix': [1, 0], 'x': 110, 'y': 10},
+            ],
+        },
+    }
+    lines = _gen_led_tables(info_data)
+
+    assert lines[0] == '#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_LED_TABLES)'
+    assert lines[1] == 'const led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT] PROGMEM = { {0, 0}, {20, 0}, {10, 192}, {100, 0} };'
+    assert lines[2] == 'const keypos_t g_led_matrix_pos[RGB_MATRIX_LED_COUNT] PROGMEM = { {0, 0}, {1, 0}, {255, 255}, {0, 1} };'
+    # Neighbours are sorted by distance, and the last LED is out of reach of every other one
+    assert lines[3] == 'const uint16_t g_led_neighbour_offsets[RGB_MATRIX_LED_COUNT + 1] PROGMEM = { 0, 2, 4, 6, 6 };'
+    assert lines[4] == 'const led_neighbour_t g_led_neighbours[] PROGMEM = { {2, 10}, {1, 20}, {0, 20}, {2, 22}, {0, 10}, {1, 22} };'
+    assert lines[5] == '#endif'
+
+
+def test_gen_led_tables_without_neighbours():
+    info_data = {
+        'rgb_matrix': {
+            'neighbour_radius': 5,
+            'layout': [
+                {'matrix': [0, 0], 'x': 0, 'y': 0},
+                {'matrix': [0, 1], 'x': 224, 'y': 64},
+            ],
+        },
+    }
+    lines = _gen_led_tables(info_data)
+
+    assert lines[3] == 'const uint16_t g_led_neighbour_offsets[RGB_MATRIX_LED_COUNT + 1] PROGMEM = { 0, 0, 0 };'
+    assert lines[4] == 'const led_neighbour_t g_led_neighbours[] PROGMEM = { {NO_LED, 0} };'
@@ -38,11 +38,55 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSACTION_ASYNC
+
+static binary_semaphore_t initiator_start;
+static binary_semaphore_t initiator_idle;
+static volatile uint8_t   initiator_transaction_id;
+static volatile bool      initiator_success;
+static volatile bool      initiator_finished;
+
+/**
+ * @brief This thread runs on the master and performs the transactions started
+ * with soft_serial_transaction_start(), so that the main loop can carry on
+ * while the driver moves the data.
+ */
+static THD_WORKING_AREA(waInitiatorThread, 512);
+static THD_FUNCTION(InitiatorThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&initiator_start);
+
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        serial_transport_driver_clear();
+        bool success = initiate_transaction(initiator_transaction_id);
+
+        osalSysLock();
+        initiator_success  = success;
+        initiator_finished = true;
+        osalSysUnlock();
+        chBSemSignal(&initiator_idle);
+    }
+}
+
+#endif // SPLIT_TRANSACTION_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSACTION_ASYNC
+    chBSemObjectInit(&initiator_start, true);
+    chBSemObjectInit(&initiator_idle, false);
+
+    /* Start transport thread. */
+    chThdCreateStatic(waInitiatorThread, sizeof(waInitiatorThread), HIGHPRIO, InitiatorThread, NULL);
+#endif // SPLIT_TRANSACTION_ASYNC
 }
 
 /**
@@ -100,13 +144,64 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSACTION_ASYNC
+    /* Wait for any transaction running in the background to finish. */
+    chBSemWait(&initiator_idle);
+#endif // SPLIT_TRANSACTION_ASYNC
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
-    return initiate_transaction((uint8_t)index);
+    bool success = initiate_transaction((uint8_t)index);
+
+#ifdef SPLIT_TRANSACTION_ASYNC
+    chBSemSignal(&initiator_idle);
+#endif // SPLIT_TRANSACTION_ASYNC
+    return success;
+}
+
+#ifdef SPLIT_TRANSACTION_ASYNC
+
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to complete.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if a transaction is still in progress.
+ */
+bool soft_serial_transaction_start(int index) {
+    if (chBSemWaitTimeout(&initiator_idle, TIME_IMMEDIATE) != MSG_OK) {
+        return false;
+    }
+
+    osalSysLock();
+    initiator_transaction_id = (uint8_t)index;
+    initiator_finished       = false;
+    osalSysUnlock();
+    chBSemSignal(&initiator_start);
+    return true;
+}
+
+/**
+ * @brief Check whether the transaction started in the background has completed.
+ *
+ * @param success Set to the outcome of the transaction once it has completed.
+ * @return bool true once, after the transaction has completed.
+ */
+bool soft_serial_transaction_finished(bool* success) {
+    osalSysLock();
+    bool finished = initiator_finished;
+    if (finished) {
+        *success           = initiator_success;
+        initiator_finished = false;
+    }
+    osalSysUnlock();
+    return finished;
 }
 
+#endif // SPLIT_TRANSACTION_ASYNC
+
 /**
  * @brief Initiate transaction to slave half.
  */
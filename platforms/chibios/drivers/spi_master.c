@@ -59,7 +59,8 @@
 #    endif
 #endif
 
-static bool spiStarted = false;
+static bool spiStarted      = false;
+static bool spiAsyncPending = false;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t current_slave_pin     = NO_PIN;
 static bool  current_cs_active_low = true;
@@ -421,7 +422,20 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     return spi_start_extended(&start_config);
 }
 
+void spi_wait(void) {
+    if (spiAsyncPending) {
+        osalSysLock();
+        if (SPI_DRIVER.state == SPI_ACTIVE) {
+            _spi_wait_s(&SPI_DRIVER);
+        }
+        osalSysUnlock();
+        spiAsyncPending = false;
+    }
+}
+
 spi_status_t spi_write(uint8_t data) {
+    spi_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -429,6 +443,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -436,16 +452,27 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_wait();
+    spiStartSend(&SPI_DRIVER, length, data);
+    spiAsyncPending = true;
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
+    spi_wait();
+
     if (spiStarted) {
         spi_unselect();
         spiStop(&SPI_DRIVER);
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ws2812.h"
 #include "gpio.h"
 #include "chibios_config.h"
@@ -394,13 +395,22 @@ void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b,
 
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+// Range of LEDs changed since the last flush, everything needs encoding after startup
+static int dirty_start = 0;
+static int dirty_end   = WS2812_LED_COUNT;
+
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-    ws2812_leds[index].r = red;
-    ws2812_leds[index].g = green;
-    ws2812_leds[index].b = blue;
+    ws2812_led_t led = {.r = red, .g = green, .b = blue};
 #if defined(WS2812_RGBW)
-    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+    ws2812_rgb_to_rgbw(&led);
 #endif
+    if (memcmp(&ws2812_leds[index], &led, sizeof(led)) == 0) {
+        return;
+    }
+
+    ws2812_leds[index] = led;
+    if (index < dirty_start) dirty_start = index;
+    if (index >= dirty_end) dirty_end = index + 1;
 }
 
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -410,11 +420,14 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void ws2812_flush(void) {
-    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+    // Only re-encode the LEDs that changed, the rest of the frame buffer is still valid
+    for (int i = dirty_start; i < dirty_end; i++) {
 #if defined(WS2812_RGBW)
         ws2812_write_led_rgbw(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b, ws2812_leds[i].w);
 #else
         ws2812_write_led(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b);
 #endif
     }
+    dirty_start = WS2812_LED_COUNT;
+    dirty_end   = 0;
 }
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ws2812.h"
 #include "gpio.h"
 #include "util.h"
@@ -117,55 +118,67 @@ static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, we use this table to translate bytes into 0s and 1s
+ * for the LED (with the appropriate timing). Each SPI byte carries two data
+ * bits, as 0b1000 for a 0 and 0b1110 for a 1, so every nibble of a color
+ * channel maps to two SPI bytes.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+static const uint8_t protocol_eq_table[16][2] = {
+    {0x88, 0x88}, // 0b0000
+    {0x88, 0x8E}, // 0b0001
+    {0x88, 0xE8}, // 0b0010
+    {0x88, 0xEE}, // 0b0011
+    {0x8E, 0x88}, // 0b0100
+    {0x8E, 0x8E}, // 0b0101
+    {0x8E, 0xE8}, // 0b0110
+    {0x8E, 0xEE}, // 0b0111
+    {0xE8, 0x88}, // 0b1000
+    {0xE8, 0x8E}, // 0b1001
+    {0xE8, 0xE8}, // 0b1010
+    {0xE8, 0xEE}, // 0b1011
+    {0xEE, 0x88}, // 0b1100
+    {0xEE, 0x8E}, // 0b1101
+    {0xEE, 0xE8}, // 0b1110
+    {0xEE, 0xEE}, // 0b1111
+};
+
+static inline void set_protocol_eq(uint8_t* dest, uint8_t data) {
+    const uint8_t* hi = protocol_eq_table[data >> 4];
+    const uint8_t* lo = protocol_eq_table[data & 0x0F];
+
+    dest[0] = hi[0];
+    dest[1] = hi[1];
+    dest[2] = lo[0];
+    dest[3] = lo[1];
 }
 
 static void set_led_color_rgb(ws2812_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_protocol_eq(tx_start, color.g);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE, color.r);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_protocol_eq(tx_start, color.r);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    set_protocol_eq(tx_start, color.b);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 #ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+    set_protocol_eq(tx_start + BYTES_FOR_LED_BYTE * 3, color.w);
 #endif
 }
 
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+// Range of LEDs changed since the last flush, everything needs encoding after startup
+static int dirty_start = 0;
+static int dirty_end   = WS2812_LED_COUNT;
+
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -225,12 +238,17 @@ void ws2812_init(void) {
 }
 
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-    ws2812_leds[index].r = red;
-    ws2812_leds[index].g = green;
-    ws2812_leds[index].b = blue;
+    ws2812_led_t led = {.r = red, .g = green, .b = blue};
 #if defined(WS2812_RGBW)
-    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+    ws2812_rgb_to_rgbw(&led);
 #endif
+    if (memcmp(&ws2812_leds[index], &led, sizeof(led)) == 0) {
+        return;
+    }
+
+    ws2812_leds[index] = led;
+    if (index < dirty_start) dirty_start = index;
+    if (index >= dirty_end) dirty_end = index + 1;
 }
 
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -240,9 +258,12 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void ws2812_flush(void) {
-    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+    // Only re-encode the LEDs that changed, the rest of the buffer is still valid
+    for (int i = dirty_start; i < dirty_end; i++) {
         set_led_color_rgb(ws2812_leds[i], i);
     }
+    dirty_start = WS2812_LED_COUNT;
+    dirty_end   = 0;
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
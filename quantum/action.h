@@ -61,6 +61,8 @@ void action_exec(keyevent_t event);
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
 action_t action_for_keycode(uint16_t keycode);
+/* action for keycode, bypassing any lookup table */
+action_t action_for_keycode_raw(uint16_t keycode);
 
 /* keyboard-specific key event (pre)processing */
 bool process_record_quantum(keyrecord_t *record);
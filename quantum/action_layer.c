@@ -7,6 +7,12 @@
 #include "util.h"
 #include "action_layer.h"
 
+#if defined(ACTION_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+#    include <string.h>
+#    include "keycode_config.h"
+#    include "matrix.h"
+#endif
+
 /** \brief Default Layer State
  */
 layer_state_t default_layer_state = 0;
@@ -289,6 +295,84 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+/** \brief Layer switch resolve layer
+ *
+ * Finds the topmost non-transparent layer for the key in the current layer state
+ */
+static uint8_t layer_switch_resolve_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    action_t action;
+    action.code = ACTION_TRANSPARENT;
+
+    layer_state_t layers = layer_state | default_layer_state;
+    /* check top layer first */
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            action = action_for_key(i, key);
+            if (action.code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+    }
+    /* fall back to layer 0 */
+    return 0;
+#else
+    return get_highest_layer(default_layer_state);
+#endif
+}
+
+#if defined(ACTION_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+/*
+ * The topmost non-transparent layer and its action, resolved on first use for each matrix position. Everything is
+ * discarded whenever the layer state or keymap config differs from when the entries were resolved.
+ */
+typedef struct action_lookup_t {
+    uint8_t  layer;
+    action_t action;
+} action_lookup_t;
+
+static action_lookup_t action_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t    action_lookup_valid[MATRIX_ROWS];
+static layer_state_t   action_lookup_layers;
+static uint16_t        action_lookup_config;
+
+void action_lookup_cache_clear(void) {
+    memset(action_lookup_valid, 0, sizeof(action_lookup_valid));
+}
+
+static const action_lookup_t *action_lookup(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+
+    layer_state_t layers = layer_state | default_layer_state;
+    if (layers != action_lookup_layers || keymap_config.raw != action_lookup_config) {
+        action_lookup_cache_clear();
+        action_lookup_layers = layers;
+        action_lookup_config = keymap_config.raw;
+    }
+
+    action_lookup_t *entry = &action_lookup_cache[key.row][key.col];
+    if (!(action_lookup_valid[key.row] & (MATRIX_ROW_SHIFTER << key.col))) {
+        entry->layer  = layer_switch_resolve_layer(key);
+        entry->action = action_for_key(entry->layer, key);
+        action_lookup_valid[key.row] |= MATRIX_ROW_SHIFTER << key.col;
+    }
+    return entry;
+}
+
+/* Same as action_for_key(), served from the cache when the layer is the one currently resolved for the key */
+static action_t layer_action_for_key(uint8_t layer, keypos_t key) {
+    const action_lookup_t *entry = action_lookup(key);
+    if (entry && entry->layer == layer) {
+        return entry->action;
+    }
+    return action_for_key(layer, key);
+}
+#else
+#    define layer_action_for_key(layer, key) action_for_key(layer, key)
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -310,7 +394,7 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
     } else {
         layer = read_source_layers_cache(key);
     }
-    return action_for_key(layer, key);
+    return layer_action_for_key(layer, key);
 #else
     return layer_switch_get_action(key);
 #endif
@@ -321,25 +405,13 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  * Gets the layer based on key info
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
-    layer_state_t layers = layer_state | default_layer_state;
-    /* check top layer first */
-    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
-        if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
-            }
-        }
+#if defined(ACTION_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+    const action_lookup_t *entry = action_lookup(key);
+    if (entry) {
+        return entry->layer;
     }
-    /* fall back to layer 0 */
-    return 0;
-#else
-    return get_highest_layer(default_layer_state);
 #endif
+    return layer_switch_resolve_layer(key);
 }
 
 /** \brief Layer switch get layer
@@ -347,7 +419,7 @@ uint8_t layer_switch_get_layer(keypos_t key) {
  * Gets action code based on key position
  */
 action_t layer_switch_get_action(keypos_t key) {
-    return action_for_key(layer_switch_get_layer(key), key);
+    return layer_action_for_key(layer_switch_get_layer(key), key);
 }
 
 #ifndef NO_ACTION_LAYER
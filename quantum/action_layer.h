@@ -168,3 +168,10 @@ uint8_t layer_switch_get_layer(keypos_t key);
 
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
+
+#if defined(ACTION_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+/* discard the resolved layer and action cached for each key, e.g. after changing the keymap */
+void action_lookup_cache_clear(void);
+#else
+#    define action_lookup_cache_clear()
+#endif
@@ -0,0 +1,181 @@
+/*
+Copyright 2024 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Per-key eager algorithm using vertical counters. Behaves exactly like
+sym_eager_pk, but the per-key counters are stored as bit-planes: bit n of
+every counter in a row lives in counters[n][row]. A whole row of counters is
+therefore updated with a handful of bitwise operations, rather than one key at
+a time, and no heap allocation is needed.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bit-planes needed to hold DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#if DEBOUNCE > 0
+static matrix_row_t debounce_counters[DEBOUNCE_PLANES][MATRIX_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    counters_need_update = false;
+    matrix_need_update   = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+// Subtract elapsed_time from every running counter in one pass per row; counters that reach zero re-enable input.
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t active = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            active |= debounce_counters[plane][row];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Ripple-borrow subtraction of the same constant from every running counter in the row
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            matrix_row_t counter    = debounce_counters[plane][row];
+            matrix_row_t subtrahend = (elapsed_time >> plane) & 1 ? (matrix_row_t)~0 : 0;
+            matrix_row_t difference = (counter ^ subtrahend ^ borrow) & active;
+
+            borrow = (~counter & (subtrahend | borrow)) | (subtrahend & borrow);
+            remaining |= difference;
+            debounce_counters[plane][row] = difference;
+        }
+
+        // Counters wider than the planes are always exceeded
+        if (elapsed_time >> DEBOUNCE_PLANES) {
+            borrow = (matrix_row_t)~0;
+        }
+
+        // A counter has elapsed if it underflowed or hit zero
+        matrix_row_t elapsed = active & (borrow | ~remaining);
+        if (elapsed) {
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                debounce_counters[plane][row] &= ~elapsed;
+            }
+            matrix_need_update = true;
+        }
+        if (active & ~elapsed) {
+            counters_need_update = true;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        if (!delta) {
+            continue;
+        }
+
+        matrix_row_t active = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            active |= debounce_counters[plane][row];
+        }
+
+        // Only keys whose counter has elapsed may change; they restart their counter at DEBOUNCE
+        matrix_row_t ready = delta & ~active;
+        if (ready) {
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                if ((DEBOUNCE >> plane) & 1) {
+                    debounce_counters[plane][row] |= ready;
+                }
+            }
+            counters_need_update = true;
+            cooked[row] ^= ready; // flip the bits.
+            cooked_changed = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
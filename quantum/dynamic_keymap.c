@@ -17,6 +17,7 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
@@ -101,6 +102,58 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#define DYNAMIC_KEYMAP_ENCODER_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Mirror of the keymap (and encoder map) as stored in EEPROM, so that lookups don't touch the EEPROM driver.
+// Loaded on first access, and written through on every update.
+static uint8_t dynamic_keymap_cache[DYNAMIC_KEYMAP_EEPROM_SIZE];
+#    ifdef ENCODER_MAP_ENABLE
+static uint8_t dynamic_keymap_encoder_cache[DYNAMIC_KEYMAP_ENCODER_EEPROM_SIZE];
+#    endif // ENCODER_MAP_ENABLE
+static bool dynamic_keymap_cache_loaded = false;
+
+static uint8_t *dynamic_keymap_cache_location(const void *address) {
+    if (!dynamic_keymap_cache_loaded) {
+        eeprom_read_block(dynamic_keymap_cache, (const void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+#    ifdef ENCODER_MAP_ENABLE
+        eeprom_read_block(dynamic_keymap_encoder_cache, (const void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, sizeof(dynamic_keymap_encoder_cache));
+#    endif // ENCODER_MAP_ENABLE
+        dynamic_keymap_cache_loaded = true;
+    }
+
+    uintptr_t offset = (uintptr_t)address - (uintptr_t)DYNAMIC_KEYMAP_EEPROM_ADDR;
+    if (offset < sizeof(dynamic_keymap_cache)) {
+        return &dynamic_keymap_cache[offset];
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    offset = (uintptr_t)address - (uintptr_t)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR;
+    if (offset < sizeof(dynamic_keymap_encoder_cache)) {
+        return &dynamic_keymap_encoder_cache[offset];
+    }
+#    endif // ENCODER_MAP_ENABLE
+    return NULL;
+}
+
+static uint8_t dynamic_keymap_read_byte(const void *address) {
+    uint8_t *cached = dynamic_keymap_cache_location(address);
+    return cached ? *cached : eeprom_read_byte(address);
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    uint8_t *cached = dynamic_keymap_cache_location(address);
+    if (cached) {
+        *cached = value;
+    }
+    // Always write through, the EEPROM may have been formatted behind the mirror's back
+    eeprom_update_byte(address, value);
+}
+#else // DYNAMIC_KEYMAP_RAM_CACHE
+#    define dynamic_keymap_read_byte(address) eeprom_read_byte(address)
+#    define dynamic_keymap_update_byte(address, value) eeprom_update_byte(address, value)
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -114,8 +167,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +176,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    action_lookup_cache_clear();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +190,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,12 +199,16 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Called after the EEPROM has been reinitialised, so the mirror no longer reflects it
+    dynamic_keymap_cache_loaded = false;
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
@@ -168,12 +226,11 @@ void dynamic_keymap_reset(void) {
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -183,16 +240,137 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
     }
+    action_lookup_cache_clear();
+}
+
+static uint16_t dynamic_keymap_get_buffer_keycode(uint16_t offset) {
+    void *address = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    return (dynamic_keymap_read_byte(address) << 8) | dynamic_keymap_read_byte(address + 1);
+}
+
+static void dynamic_keymap_set_buffer_keycode(uint16_t offset, uint16_t keycode) {
+    void *address = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+}
+
+uint16_t dynamic_keymap_get_buffer_rle(uint16_t offset, uint8_t size, uint8_t *data, uint8_t *length) {
+    uint32_t position = offset;
+    uint16_t count    = 0;
+    uint16_t used     = 0;
+    int16_t  literal  = -1; // index of the tag of the literal token still being appended to
+
+    *length = 0;
+    if (offset & 1) {
+        return 0;
+    }
+
+    while (position + 2 <= DYNAMIC_KEYMAP_EEPROM_SIZE) {
+        uint16_t keycode = dynamic_keymap_get_buffer_keycode(position);
+        if (keycode == KC_NO || keycode == KC_TRNS) {
+            if (used + 1 > size) {
+                break;
+            }
+            uint8_t run = 1;
+            while (run < DYNAMIC_KEYMAP_RLE_MAX_RUN && position + (run + 1) * 2 <= DYNAMIC_KEYMAP_EEPROM_SIZE && dynamic_keymap_get_buffer_keycode(position + run * 2) == keycode) {
+                run++;
+            }
+            data[used++] = (keycode == KC_NO ? DYNAMIC_KEYMAP_RLE_NO : DYNAMIC_KEYMAP_RLE_TRNS) | (run - 1);
+            literal      = -1;
+            count += run;
+            position += run * 2;
+        } else {
+            if (literal >= 0 && (data[literal] & DYNAMIC_KEYMAP_RLE_LITERAL_MASK) < DYNAMIC_KEYMAP_RLE_LITERAL_MASK) {
+                if (used + 2 > size) {
+                    break;
+                }
+                data[literal]++;
+            } else {
+                if (used + 3 > size) {
+                    break;
+                }
+                literal      = used;
+                data[used++] = DYNAMIC_KEYMAP_RLE_LITERAL;
+            }
+            data[used++] = (uint8_t)(keycode >> 8);
+            data[used++] = (uint8_t)(keycode & 0xFF);
+            count++;
+            position += 2;
+        }
+    }
+
+    *length = used;
+    return count;
+}
+
+static uint8_t dynamic_keymap_rle_token_length(uint8_t tag) {
+    return (tag & ((tag & DYNAMIC_KEYMAP_RLE_RUN) ? DYNAMIC_KEYMAP_RLE_RUN_MASK : DYNAMIC_KEYMAP_RLE_LITERAL_MASK)) + 1;
+}
+
+uint16_t dynamic_keymap_set_buffer_rle(uint16_t offset, uint8_t size, const uint8_t *data) {
+    if (offset & 1) {
+        return 0;
+    }
+
+    // Validate the whole stream before writing anything, so that a malformed packet leaves the keymap untouched
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < size;) {
+        uint8_t tag = data[i++];
+        uint8_t run = dynamic_keymap_rle_token_length(tag);
+        if (!(tag & DYNAMIC_KEYMAP_RLE_RUN)) {
+            if (i + run * 2 > size) {
+                return 0;
+            }
+            i += run * 2;
+        }
+        total += run;
+    }
+    if ((uint32_t)offset + total * 2 > DYNAMIC_KEYMAP_EEPROM_SIZE) {
+        return 0;
+    }
+
+    uint16_t i = 0;
+    while (i < size) {
+        uint8_t tag = data[i++];
+        uint8_t run = dynamic_keymap_rle_token_length(tag);
+        for (uint8_t j = 0; j < run; j++) {
+            uint16_t keycode;
+            if (tag & DYNAMIC_KEYMAP_RLE_RUN) {
+                keycode = (tag & DYNAMIC_KEYMAP_RLE_TRNS) == DYNAMIC_KEYMAP_RLE_TRNS ? KC_TRNS : KC_NO;
+            } else {
+                keycode = (data[i] << 8) | data[i + 1];
+                i += 2;
+            }
+            dynamic_keymap_set_buffer_keycode(offset, keycode);
+            offset += 2;
+        }
+    }
+    action_lookup_cache_clear();
+    return total;
+}
+
+uint16_t dynamic_keymap_get_buffer_crc(uint16_t offset, uint16_t size) {
+    // CRC-16/CCITT-FALSE over the bytes dynamic_keymap_get_buffer() would return
+    uint16_t crc    = 0xFFFF;
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    for (uint32_t position = offset; position < (uint32_t)offset + size; position++) {
+        uint8_t byte = (position < DYNAMIC_KEYMAP_EEPROM_SIZE) ? dynamic_keymap_read_byte(source) : 0x00;
+        crc ^= (uint16_t)byte << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+        source++;
+    }
+    return crc;
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +398,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +412,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -38,6 +38,27 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// Compressed variants of the above, for host applications that want to sync a whole keymap in far
+// fewer raw HID transfers. Offsets are in bytes, as above, but must be keycode aligned.
+// The keycodes are encoded as a sequence of tokens, each starting with a tag byte:
+//   0b0nnnnnnn: n+1 literal keycodes follow, big-endian
+//   0b10nnnnnn: a run of n+1 KC_NO
+//   0b11nnnnnn: a run of n+1 KC_TRNS
+#define DYNAMIC_KEYMAP_RLE_LITERAL 0x00
+#define DYNAMIC_KEYMAP_RLE_LITERAL_MASK 0x7F
+#define DYNAMIC_KEYMAP_RLE_RUN 0x80
+#define DYNAMIC_KEYMAP_RLE_RUN_MASK 0x3F
+#define DYNAMIC_KEYMAP_RLE_NO 0x80
+#define DYNAMIC_KEYMAP_RLE_TRNS 0xC0
+#define DYNAMIC_KEYMAP_RLE_MAX_RUN (DYNAMIC_KEYMAP_RLE_RUN_MASK + 1)
+// Encodes as many keycodes from offset as fit in size bytes; returns the number of keycodes encoded, 0 for odd offsets
+uint16_t dynamic_keymap_get_buffer_rle(uint16_t offset, uint8_t size, uint8_t *data, uint8_t *length);
+// Decodes size bytes of tokens to offset; returns the number of keycodes written, or 0 if the tokens are truncated or
+// would run past the end of the keymap, in which case nothing is written
+uint16_t dynamic_keymap_set_buffer_rle(uint16_t offset, uint8_t size, const uint8_t *data);
+// CRC-16/CCITT-FALSE of the buffer, so that hosts can skip regions that are already up to date
+uint16_t dynamic_keymap_get_buffer_crc(uint16_t offset, uint16_t size);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "scan_profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -335,6 +336,9 @@ __attribute__((weak)) void keyboard_post_init_modules(void) {}
 void keyboard_post_init_quantum(void) {
     keyboard_post_init_modules();
     keyboard_post_init_kb();
+#ifdef COMBO_ENABLE
+    combo_init();
+#endif
 }
 
 /** \brief matrix_can_read
@@ -625,6 +629,29 @@ static bool matrix_task(void) {
     return matrix_changed;
 }
 
+#ifdef MATRIX_IDLE_WAKEUP
+__attribute__((weak)) void matrix_idle_wait(void) {}
+
+/**
+ * @brief Idles until a key is pressed, once the matrix has been fully released
+ * for MATRIX_IDLE_WAKEUP_DELAY ms.
+ *
+ * Run from the main loop after every other task, so that a sleep never delays
+ * the tasks of the current loop.
+ */
+void matrix_idle_task(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return;
+        }
+    }
+
+    if (last_matrix_activity_elapsed() >= MATRIX_IDLE_WAKEUP_DELAY) {
+        matrix_idle_wait();
+    }
+}
+#endif
+
 /** \brief Tasks previously located in matrix_scan_quantum
  *
  * TODO: rationalise against keyboard_task and current split role
@@ -656,101 +683,107 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    SCAN_PROFILE(music_task());
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    SCAN_PROFILE(key_override_task());
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    SCAN_PROFILE(sequencer_task());
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    SCAN_PROFILE(tap_dance_task());
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    SCAN_PROFILE(combo_task());
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    SCAN_PROFILE(leader_task());
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    SCAN_PROFILE(decay_wpm());
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
+    SCAN_PROFILE(dip_switch_task());
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    SCAN_PROFILE(autoshift_matrix_scan());
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    SCAN_PROFILE(caps_word_task());
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    SCAN_PROFILE(secure_task());
 #endif
 
 #ifdef LAYER_LOCK_ENABLE
-    layer_lock_task();
+    SCAN_PROFILE(layer_lock_task());
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed;
+    SCAN_PROFILE_NAMED("matrix_task", matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    SCAN_PROFILE(quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+    SCAN_PROFILE(split_watchdog_task());
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    SCAN_PROFILE(rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    SCAN_PROFILE(led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    SCAN_PROFILE(rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    SCAN_PROFILE(backlight_task());
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    bool encoder_changed;
+    SCAN_PROFILE_NAMED("encoder_task", encoder_changed = encoder_task());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    SCAN_PROFILE_NAMED("pointing_device_task", pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    SCAN_PROFILE(oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -758,7 +791,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    SCAN_PROFILE(st7565_task());
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -767,32 +800,40 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    SCAN_PROFILE(mousekey_task());
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    SCAN_PROFILE(ps2_mouse_task());
 #endif
 
 #ifdef MIDI_ENABLE
-    midi_task();
+    SCAN_PROFILE(midi_task());
 #endif
 
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    SCAN_PROFILE(joystick_task());
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    SCAN_PROFILE(bluetooth_task());
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    SCAN_PROFILE(haptic_task());
 #endif
 
-    led_task();
+    SCAN_PROFILE(led_task());
 
 #ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+    SCAN_PROFILE(os_detection_task());
+#endif
+
+#ifdef EEPROM_DRIVER
+    SCAN_PROFILE(eeprom_driver_task());
+#endif
+
+#ifdef SCAN_PROFILER_ENABLE
+    scan_profiler_task();
 #endif
 }
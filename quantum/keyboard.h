@@ -109,6 +109,10 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+#ifdef MATRIX_IDLE_WAKEUP
+/* it runs at the end of the main loop, once every other task has been serviced */
+void matrix_idle_task(void);
+#endif
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
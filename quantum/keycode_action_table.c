@@ -0,0 +1,76 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "keycode_action_table.h"
+#include "keycode_actions.h"
+#include "keycode_config.h"
+#include "keymap_introspection.h"
+
+#if (KEYCODE_ACTION_TABLE_SIZE & (KEYCODE_ACTION_TABLE_SIZE - 1)) != 0
+#    error "KEYCODE_ACTION_TABLE_SIZE must be a power of two"
+#endif
+
+#define KEYCODE_ACTION_TABLE_MASK (KEYCODE_ACTION_TABLE_SIZE - 1)
+
+typedef struct keycode_action_entry_t {
+    uint16_t keycode; // KC_NO marks an empty slot
+    action_t action;
+} keycode_action_entry_t;
+
+static keycode_action_entry_t keycode_action_table[KEYCODE_ACTION_TABLE_SIZE];
+static uint16_t               keycode_action_table_config;
+static bool                   keycode_action_table_valid = false;
+
+static inline uint16_t keycode_action_table_hash(uint16_t keycode) {
+    // Fold the high byte in first, as only the low bits of the product are used
+    return (uint16_t)((keycode ^ (keycode >> 7)) * 40503u) & KEYCODE_ACTION_TABLE_MASK;
+}
+
+void keycode_action_table_init(void) {
+    uint16_t used = 0;
+
+    memset(keycode_action_table, 0, sizeof(keycode_action_table));
+    keycode_action_table_config = keymap_config.raw;
+    keycode_action_table_valid  = true;
+
+    for (uint16_t i = 0; i < keycode_action_table_count_raw(); i++) {
+        uint16_t keycode = keycode_action_table_keycode_raw(i);
+        if (keycode == KC_NO) {
+            continue;
+        }
+
+        uint16_t slot = keycode_action_table_hash(keycode);
+        while (keycode_action_table[slot].keycode != KC_NO && keycode_action_table[slot].keycode != keycode) {
+            slot = (slot + 1) & KEYCODE_ACTION_TABLE_MASK;
+        }
+        if (keycode_action_table[slot].keycode == keycode) {
+            continue;
+        }
+
+        // Always leave an empty slot behind, so that lookups of missing keycodes terminate
+        if (++used >= KEYCODE_ACTION_TABLE_SIZE) {
+            break;
+        }
+        keycode_action_table[slot].keycode = keycode;
+        keycode_action_table[slot].action  = action_for_keycode_raw(keycode);
+    }
+}
+
+bool keycode_action_table_lookup(uint16_t keycode, action_t *action) {
+    if (!keycode_action_table_valid || keycode_action_table_config != keymap_config.raw) {
+        keycode_action_table_init();
+    }
+
+    if (keycode == KC_NO) {
+        return false;
+    }
+
+    for (uint16_t slot = keycode_action_table_hash(keycode); keycode_action_table[slot].keycode != KC_NO; slot = (slot + 1) & KEYCODE_ACTION_TABLE_MASK) {
+        if (keycode_action_table[slot].keycode == keycode) {
+            *action = keycode_action_table[slot].action;
+            return true;
+        }
+    }
+    return false;
+}
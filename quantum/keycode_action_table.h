@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Keycode action table: resolves the keycodes used by a keymap.json to their actions with a hash
+    table lookup, rather than running the full keycode decode on every key event.
+
+    The list of keycodes is generated at build time by `qmk generate-keycode-actions-h`. The actions
+    themselves depend on keymap_config (swapped modifiers and the like), so they are decoded into RAM
+    on first use and again whenever keymap_config changes. Keycodes that are not in the table, such as
+    ones assigned later through dynamic keymaps, fall back to action_for_keycode_raw().
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "action.h"
+
+/**
+ * @brief Decodes the action for every keycode the keymap was generated with.
+ *
+ * Invoked automatically on the first lookup and whenever keymap_config changes.
+ */
+void keycode_action_table_init(void);
+
+/**
+ * @brief Looks up the action for the given keycode.
+ *
+ * @return false if the keycode is not in the table
+ */
+bool keycode_action_table_lookup(uint16_t keycode, action_t *action);
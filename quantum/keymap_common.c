@@ -41,6 +41,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "process_midi.h"
 #endif
 
+#ifdef KEYCODE_ACTION_TABLE_ENABLE
+#    include "keycode_action_table.h"
+#endif
+
 extern keymap_config_t keymap_config;
 
 #include <inttypes.h>
@@ -53,6 +57,16 @@ action_t action_for_key(uint8_t layer, keypos_t key) {
 };
 
 action_t action_for_keycode(uint16_t keycode) {
+#ifdef KEYCODE_ACTION_TABLE_ENABLE
+    action_t action;
+    if (keycode_action_table_lookup(keycode, &action)) {
+        return action;
+    }
+#endif
+    return action_for_keycode_raw(keycode);
+}
+
+action_t action_for_keycode_raw(uint16_t keycode) {
     // keycode remapping
     keycode = keycode_config(keycode);
 
@@ -176,6 +176,29 @@ __attribute__((weak)) const key_override_t* key_override_get(uint16_t key_overri
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Keycode action table
+
+#if defined(KEYCODE_ACTION_TABLE_ENABLE)
+
+#    include "keycode_actions.h"
+
+// Terminated with KC_NO so that a keymap without any keycodes still yields a valid initializer
+static const uint16_t PROGMEM keycode_action_table_keycodes[] = {KEYCODE_ACTION_TABLE_KEYCODES KC_NO};
+
+uint16_t keycode_action_table_count_raw(void) {
+    return ARRAY_SIZE(keycode_action_table_keycodes) - 1;
+}
+
+uint16_t keycode_action_table_keycode_raw(uint16_t keycode_idx) {
+    if (keycode_idx >= keycode_action_table_count_raw()) {
+        return KC_NO;
+    }
+    return pgm_read_word(&keycode_action_table_keycodes[keycode_idx]);
+}
+
+#endif // defined(KEYCODE_ACTION_TABLE_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Community modules (must be last in this file!)
 
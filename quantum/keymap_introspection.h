@@ -109,3 +109,16 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Keycode action table
+
+#if defined(KEYCODE_ACTION_TABLE_ENABLE)
+
+// Get the number of distinct keycodes the keymap was generated with
+uint16_t keycode_action_table_count_raw(void);
+
+// Get one of the distinct keycodes the keymap was generated with
+uint16_t keycode_action_table_keycode_raw(uint16_t keycode_idx);
+
+#endif // defined(KEYCODE_ACTION_TABLE_ENABLE)
@@ -73,5 +73,10 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef MATRIX_IDLE_WAKEUP
+        // Idle once everything else has been serviced
+        matrix_idle_task();
+#endif
     }
 }
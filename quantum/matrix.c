@@ -270,6 +270,114 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_WAKEUP
+#    ifdef SPLIT_KEYBOARD
+#        error "MATRIX_IDLE_WAKEUP is not supported on split keyboards"
+#    endif
+#    if !defined(DIRECT_PINS) && !(defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS))
+#        error "MATRIX_IDLE_WAKEUP requires DIRECT_PINS or MATRIX_ROW_PINS/MATRIX_COL_PINS"
+#    endif
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "MATRIX_IDLE_WAKEUP is only supported on ChibiOS"
+#    endif
+#    if !defined(PAL_USE_CALLBACKS) || (PAL_USE_CALLBACKS != TRUE)
+#        error "MATRIX_IDLE_WAKEUP requires PAL_USE_CALLBACKS to be enabled in halconf.h"
+#    endif
+
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+#        define MATRIX_IDLE_WAKEUP_EVENT_MODE PAL_EVENT_MODE_FALLING_EDGE
+#    else
+#        define MATRIX_IDLE_WAKEUP_EVENT_MODE PAL_EVENT_MODE_RISING_EDGE
+#    endif
+
+static binary_semaphore_t matrix_idle_sem;
+
+static void matrix_idle_wakeup_cb(void *arg) {
+    chSysLockFromISR();
+    chBSemSignalI(&matrix_idle_sem);
+    chSysUnlockFromISR();
+}
+
+static bool matrix_idle_arm_pin(pin_t pin) {
+    if (pin == NO_PIN) {
+        return false;
+    }
+    // Leave lines that are already in use, e.g. by encoders or a pointing device motion pin, alone. Keys on
+    // those are then only picked up once the idle period times out.
+    palevent_t *event = palGetLineEvent(pin);
+    if (event->cb == NULL) {
+        palEnableLineEvent(pin, MATRIX_IDLE_WAKEUP_EVENT_MODE);
+        palSetLineCallback(pin, matrix_idle_wakeup_cb, NULL);
+    }
+    return readMatrixPin(pin) == 0;
+}
+
+static void matrix_idle_disarm_pin(pin_t pin) {
+    if (pin != NO_PIN && palGetLineEvent(pin)->cb == matrix_idle_wakeup_cb) {
+        palDisableLineEvent(pin);
+        palSetLineCallback(pin, NULL, NULL);
+    }
+}
+
+/**
+ * @brief Selects every output line so that any keypress shows up as an edge on
+ * an input line, then sleeps until such an edge arrives or the timeout expires.
+ */
+void matrix_idle_wait(void) {
+    bool pressed = false;
+
+    chBSemReset(&matrix_idle_sem, true);
+
+#    if defined(DIRECT_PINS)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pressed |= matrix_idle_arm_pin(direct_pins[row][col]);
+        }
+    }
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pressed |= matrix_idle_arm_pin(col_pins[col]);
+    }
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        pressed |= matrix_idle_arm_pin(row_pins[row]);
+    }
+#    endif
+
+    // Skip the sleep if something was pressed before the events were armed
+    if (!pressed) {
+        chBSemWaitTimeout(&matrix_idle_sem, TIME_MS2I(MATRIX_IDLE_WAKEUP_MAX_SLEEP));
+    }
+
+#    if defined(DIRECT_PINS)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_idle_disarm_pin(direct_pins[row][col]);
+        }
+    }
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        matrix_idle_disarm_pin(col_pins[col]);
+    }
+    unselect_rows();
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        matrix_idle_disarm_pin(row_pins[row]);
+    }
+    unselect_cols();
+#    endif
+    matrix_output_unselect_delay(0, true);
+}
+#endif // MATRIX_IDLE_WAKEUP
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -309,6 +417,10 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#ifdef MATRIX_IDLE_WAKEUP
+    chBSemObjectInit(&matrix_idle_sem, true);
+#endif
+
     matrix_init_kb();
 }
 
@@ -345,5 +457,6 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
     return (uint8_t)changed;
 }
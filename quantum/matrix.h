@@ -37,6 +37,17 @@ typedef uint32_t matrix_row_t;
 
 #define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
 
+#ifdef MATRIX_IDLE_WAKEUP
+// How long the matrix needs to be fully released before idling
+#    ifndef MATRIX_IDLE_WAKEUP_DELAY
+#        define MATRIX_IDLE_WAKEUP_DELAY 250
+#    endif
+// Upper bound on a single idle period, so that timers and animations still get serviced
+#    ifndef MATRIX_IDLE_WAKEUP_MAX_SLEEP
+#        define MATRIX_IDLE_WAKEUP_MAX_SLEEP 10
+#    endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,6 +80,11 @@ void matrix_io_delay(void);
 void matrix_power_up(void);
 void matrix_power_down(void);
 
+#ifdef MATRIX_IDLE_WAKEUP
+/* idle until a key is pressed, called from matrix_idle_task */
+void matrix_idle_wait(void);
+#endif
+
 void matrix_init_kb(void);
 void matrix_scan_kb(void);
 
@@ -22,6 +22,7 @@
 #include "timer.h"
 #include "print.h"
 #include "debug.h"
+#include "util.h"
 #include "mousekey.h"
 
 static inline int8_t times_inv_sqrt2(int8_t x) {
@@ -304,6 +305,136 @@ static int8_t calc_inertia(int8_t direction, int8_t velocity) {
 
 #    endif
 
+#    ifdef MOUSEKEY_SMOOTH
+
+/*
+ * Smooth acceleration
+ *
+ * Instead of sending a step every mk_interval, the speed is looked up in a curve of fractions of the maximum speed, and
+ * the position of each axis is integrated in fixed point every MOUSEKEY_SMOOTH_INTERVAL. Whole counts are sent as soon
+ * as they add up, and the fractions are kept for the next report.
+ */
+static const uint16_t mousekey_smooth_curve[] = MOUSEKEY_SMOOTH_CURVE;
+
+typedef struct {
+    uint16_t timer;        // time of the last integration step
+    uint16_t held;         // time the keys have been held for, stops at the end of the curve
+    int32_t  remainder[2]; // motion not sent yet, in 1/256th counts times the interval
+} mousekey_smooth_t;
+
+static mousekey_smooth_t mousekey_smooth_cursor = {0};
+static mousekey_smooth_t mousekey_smooth_wheel  = {0};
+
+static void mousekey_smooth_reset(mousekey_smooth_t *state) {
+    state->timer        = timer_read();
+    state->held         = 0;
+    state->remainder[0] = 0;
+    state->remainder[1] = 0;
+}
+
+/**
+ * @brief Looks up the speed in the acceleration curve
+ *
+ * @param[in] held time in milliseconds since the keys were pressed, including the delay
+ * @param[in] delay time in milliseconds before the movement starts
+ * @param[in] ramp time in milliseconds until the end of the curve is reached
+ * @param[in] max_speed speed at the end of the curve, in counts per interval
+ * @param[in] max largest value of the report
+ * @return speed in 1/256th counts per interval
+ */
+static uint32_t mousekey_smooth_speed(uint16_t held, uint16_t delay, uint16_t ramp, uint16_t max_speed, uint8_t max) {
+    const uint8_t last = ARRAY_SIZE(mousekey_smooth_curve) - 1;
+    uint16_t      gain;
+
+    if (held < delay) {
+        return 0;
+    }
+    held -= delay;
+
+    if (mousekey_accel & (1 << 0)) {
+        gain = 64;
+    } else if (mousekey_accel & (1 << 1)) {
+        gain = 128;
+    } else if (mousekey_accel & (1 << 2)) {
+        gain = 256;
+    } else if (held >= ramp) {
+        gain = mousekey_smooth_curve[last];
+    } else {
+        uint32_t position = (uint32_t)held * last;
+        uint8_t  index    = position / ramp;
+        int32_t  low      = mousekey_smooth_curve[index];
+        int32_t  high     = mousekey_smooth_curve[index + 1];
+
+        gain = low + (high - low) * (int32_t)(position % ramp) / ramp;
+    }
+
+    uint32_t speed = (uint32_t)max_speed * gain;
+    if (speed > (uint32_t)max * 256) {
+        speed = (uint32_t)max * 256;
+    } else if (speed < 256) {
+        speed = 256;
+    }
+    return speed;
+}
+
+/**
+ * @brief Advances a pair of axes and takes the whole counts they moved by
+ *
+ * @param[in] state integrator of the pair of axes
+ * @param[in,out] axes held direction of each axis in, counts to send out
+ * @param[in] delay time in milliseconds before the movement starts
+ * @param[in] interval time in milliseconds the speeds are given for
+ * @param[in] delta step size, scaled by the acceleration curve
+ * @param[in] max_speed multiplier of the step size at the end of the curve
+ * @param[in] time_to_max number of intervals until the end of the curve is reached
+ * @param[in] max largest value of the report
+ */
+static void mousekey_smooth_step(mousekey_smooth_t *state, int16_t axes[2], uint16_t delay, uint8_t interval, uint8_t delta, uint8_t max_speed, uint8_t time_to_max, uint8_t max) {
+    uint16_t elapsed = timer_elapsed(state->timer);
+
+    axes[0] = axes[0] > 0 ? 1 : (axes[0] < 0 ? -1 : 0);
+    axes[1] = axes[1] > 0 ? 1 : (axes[1] < 0 ? -1 : 0);
+    if (elapsed < MOUSEKEY_SMOOTH_INTERVAL) {
+        axes[0] = axes[1] = 0;
+        return;
+    }
+    state->timer += elapsed;
+    if (elapsed > UINT8_MAX) {
+        elapsed = UINT8_MAX;
+    }
+    if (interval == 0) {
+        interval = 1;
+    }
+
+    uint16_t ramp  = (uint16_t)time_to_max * interval;
+    uint32_t held  = (uint32_t)state->held + elapsed;
+    uint32_t speed = mousekey_smooth_speed(state->held, delay, ramp, (uint16_t)delta * max_speed, max);
+
+    state->held = MIN(held, (uint32_t)delay + ramp);
+
+    /* diagonal move [1/sqrt(2)] */
+    if (axes[0] && axes[1]) {
+        speed = speed * 181 / 256;
+    }
+
+    const int32_t unit  = (int32_t)interval * 256;
+    const int32_t limit = unit * max;
+    for (uint8_t i = 0; i < 2; i++) {
+        int32_t remainder = state->remainder[i] + axes[i] * (int32_t)(speed * elapsed);
+
+        if (remainder > limit) {
+            remainder = limit;
+        } else if (remainder < -limit) {
+            remainder = -limit;
+        }
+        // Division truncates towards zero, so the fraction that is left keeps its sign
+        axes[i]             = remainder / unit;
+        state->remainder[i] = remainder - axes[i] * unit;
+    }
+}
+
+#    endif
+
 void mousekey_task(void) {
     // report cursor and scroll movement independently
     report_mouse_t tmpmr = mouse_report;
@@ -337,6 +468,18 @@ void mousekey_task(void) {
         tmpmr.y        = 0;
     }
 
+#    elif defined(MOUSEKEY_SMOOTH)
+
+    if (tmpmr.x || tmpmr.y) {
+        int16_t axes[2] = {tmpmr.x, tmpmr.y};
+
+        mousekey_smooth_step(&mousekey_smooth_cursor, axes, mk_delay * 10, mk_interval, MOUSEKEY_MOVE_DELTA, mk_max_speed, mk_time_to_max, MOUSEKEY_MOVE_MAX);
+        mouse_report.x = axes[0];
+        mouse_report.y = axes[1];
+    } else {
+        mousekey_smooth_reset(&mousekey_smooth_cursor);
+    }
+
 #    else // default acceleration
 
     if ((tmpmr.x || tmpmr.y) && timer_elapsed(last_timer_c) > (mousekey_repeat ? mk_interval : mk_delay * 10)) {
@@ -359,6 +502,20 @@ void mousekey_task(void) {
 
 #    endif // MOUSEKEY_INERTIA or not
 
+#    ifdef MOUSEKEY_SMOOTH
+
+    if (tmpmr.v || tmpmr.h) {
+        int16_t axes[2] = {tmpmr.v, tmpmr.h};
+
+        mousekey_smooth_step(&mousekey_smooth_wheel, axes, mk_wheel_delay * 10, mk_wheel_interval, MOUSEKEY_WHEEL_DELTA, mk_wheel_max_speed, mk_wheel_time_to_max, MOUSEKEY_WHEEL_MAX);
+        mouse_report.v = axes[0];
+        mouse_report.h = axes[1];
+    } else {
+        mousekey_smooth_reset(&mousekey_smooth_wheel);
+    }
+
+#    else // default acceleration
+
     if ((tmpmr.v || tmpmr.h) && timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
         if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
         if (tmpmr.v != 0) mouse_report.v = wheel_unit() * ((tmpmr.v > 0) ? 1 : -1);
@@ -377,6 +534,8 @@ void mousekey_task(void) {
         }
     }
 
+#    endif // MOUSEKEY_SMOOTH or not
+
     if (has_mouse_report_changed(&mouse_report, &tmpmr) || should_mousekey_report_send(&mouse_report)) {
         mousekey_send();
     }
@@ -650,6 +809,10 @@ void mousekey_clear(void) {
     mousekey_x_dir     = 0;
     mousekey_y_dir     = 0;
 #endif
+#ifdef MOUSEKEY_SMOOTH
+    mousekey_smooth_reset(&mousekey_smooth_cursor);
+    mousekey_smooth_reset(&mousekey_smooth_wheel);
+#endif
 }
 
 static void mousekey_debug(void) {
@@ -119,6 +119,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    ifndef MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS
 #        define MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS 8
 #    endif
+#    ifndef MOUSEKEY_SMOOTH_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define MOUSEKEY_SMOOTH_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define MOUSEKEY_SMOOTH_INTERVAL 1
+#        endif
+#    endif
+#    ifndef MOUSEKEY_SMOOTH_CURVE
+#        define MOUSEKEY_SMOOTH_CURVE {0, 32, 64, 96, 128, 160, 192, 224, 256}
+#    endif
 
 #else /* #ifndef MK_3_SPEED */
 
@@ -174,6 +184,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #endif /* #ifndef MK_3_SPEED */
 
+#if defined(MOUSEKEY_SMOOTH) && (defined(MK_3_SPEED) || defined(MK_KINETIC_SPEED) || defined(MK_COMBINED) || defined(MOUSEKEY_INERTIA))
+#    error "MOUSEKEY_SMOOTH can only be used with the default accelerated mode"
+#endif
+
 #ifndef MOUSEKEY_OVERLAP_MOVE_DELTA
 #    define MOUSEKEY_OVERLAP_MOVE_DELTA MOUSEKEY_MOVE_DELTA
 #endif
@@ -56,6 +56,14 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def The number of recently drawn unicode glyphs to remember the location of, so that repeatedly drawn text does not
+ *      need to search the font's unicode table each time. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +80,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether a second pixel data buffer is allocated, so that images and fonts can be decoded into one
+ *      buffer while the other is still being transmitted. Only has an effect with comms drivers that support
+ *      asynchronous transfers, such as SPI on ChibiOS. Doubles the RAM used by QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
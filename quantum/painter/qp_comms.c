@@ -46,6 +46,20 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+bool qp_comms_async(painter_device_t device, bool enable) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!driver->comms_vtable->comms_async) {
+        return false;
+    }
+
+    return driver->comms_vtable->comms_async(device, enable);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -16,6 +16,10 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+// Enables or disables asynchronous sends, returning false if unsupported by the comms driver. While enabled, the data
+// supplied to qp_comms_send() must be left untouched until the next send; disabling waits for the last send to finish.
+bool qp_comms_async(painter_device_t device, bool enable);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
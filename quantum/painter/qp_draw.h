@@ -12,6 +12,11 @@
 // Global variable used for native pixel data streaming.
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Second pixel data buffer, filled by the image and font decoders while the first one is still being transmitted.
+extern uint8_t qp_internal_global_pixdata_back_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
 
@@ -27,15 +32,6 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
-// Convert from input pixel data + palette to equivalent pixels
-typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
-typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
-typedef bool (*qp_internal_byte_output_callback)(uint8_t byte, void* cb_arg);
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
-
 // Global variable used for interpolated pixel lookup table.
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 extern qp_pixel_t qp_internal_global_pixel_lookup_table[256];
@@ -64,9 +60,10 @@ enum qp_internal_rle_mode_t {
 };
 
 typedef struct qp_internal_byte_input_state_t {
-    painter_device_t device;
-    qp_stream_t*     src_stream;
-    int16_t          curr;
+    painter_device_t      device;
+    qp_stream_t*          src_stream;
+    painter_compression_t compression;
+    int16_t               curr;
     union {
         // RLE-specific
         struct {
@@ -78,23 +75,22 @@ typedef struct qp_internal_byte_input_state_t {
 
 typedef struct qp_internal_pixel_output_state_t {
     painter_device_t device;
+    uint8_t*         buffer;
     uint32_t         pixel_write_pos;
     uint32_t         max_pixels;
 } qp_internal_pixel_output_state_t;
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
-
 typedef struct qp_internal_byte_output_state_t {
     painter_device_t device;
+    uint8_t*         buffer;
     uint32_t         byte_write_pos;
     uint32_t         max_bytes;
 } qp_internal_byte_output_state_t;
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
-
-// Helper shared between image and font rendering, sends pixels to the display using:
-//     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
-//     - qp_internal_send_bytes                                  (bpp > 8)
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
+// Helper shared between image and font rendering, decodes the input in blocks and sends pixels to the display using:
+//     - the palette set up in qp_internal_global_pixel_lookup_table (bpp <= 8)
+//     - the raw pixel data                                          (bpp > 8)
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state);
 
-qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
+// Sets up the input state to decode data with the given compression scheme, returns false if the scheme is unsupported
+bool qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
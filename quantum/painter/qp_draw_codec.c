@@ -2,6 +2,7 @@
 // Copyright 2023 Pablo Martinez (@elpekenin) <elpekenin@elpekenin.dev>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
@@ -9,210 +10,221 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Palette / Monochrome-format decoder
 
-static const qp_pixel_t qp_pixel_white = {.hsv888 = {.h = 0, .s = 0, .v = 255}};
-static const qp_pixel_t qp_pixel_black = {.hsv888 = {.h = 0, .s = 0, .v = 0}};
-
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
 #if !(QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)
 #    if !(QUANTUM_PAINTER_SUPPORTS_256_PALETTE)
     if (bits_per_pixel > 4) {
-        qp_dprintf("qp_internal_decode_palette: image bpp greater than 4\n");
+        qp_dprintf("qp_internal_bpp_capable: image bpp greater than 4\n");
         return false;
     }
 #    endif
 
     if (bits_per_pixel > 8) {
-        qp_dprintf("qp_internal_decode_palette: image bpp greater than 8\n");
+        qp_dprintf("qp_internal_bpp_capable: image bpp greater than 8\n");
         return false;
     }
 #endif
     return true;
 }
 
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
-    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
-    uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
-    while (remaining_pixels > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
-            return false;
-        }
-        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
-        for (uint8_t q = 0; q < loop_pixels; ++q) {
-            if (!output_callback(palette, byteval & pixel_bitmask, output_arg)) {
-                return false;
-            }
-            byteval >>= bits_per_pixel;
-        }
-        remaining_pixels -= loop_pixels;
-    }
-    return true;
-}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Progressive pull of bytes, push of pixels
 
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    return qp_internal_decode_recolor(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_pixel_white, qp_pixel_black, output_callback, output_arg);
+// Swaps to the other pixdata buffer after a transmission, so decoding can continue while it is still being sent
+static inline uint8_t* qp_internal_next_pixdata_buffer(uint8_t* buffer) {
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    return (buffer == qp_internal_global_pixdata_buffer) ? qp_internal_global_pixdata_back_buffer : qp_internal_global_pixdata_buffer;
+#else
+    return buffer;
+#endif
 }
 
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-    int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
-    if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
-        if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
-            return false;
-        }
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Block decoding, used when rendering images and fonts
+
+// Number of pixels decoded at a time -- must be a multiple of 8 so that packed pixels never straddle two blocks
+#define QP_INTERNAL_DECODE_BLOCK_PIXELS 64
+
+// Reads the next length bytes of decompressed data, returning the number of bytes actually read
+static uint32_t qp_internal_read_block(qp_internal_byte_input_state_t* state, uint8_t* output, uint32_t length) {
+    if (state->compression != IMAGE_COMPRESSED_RLE) {
+        return qp_stream_read(output, 1, length, state->src_stream);
     }
 
-    return qp_internal_decode_palette(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
-}
+    uint32_t count = 0;
+    while (count < length) {
+        // Parse the marker byte, and the repeated byte if it's a repeating run
+        if (state->rle.mode == MARKER_BYTE) {
+            int16_t c = qp_stream_get(state->src_stream);
+            if (c < 0) {
+                break;
+            }
+            if (c >= 128) {
+                state->rle.mode   = NON_REPEATING_RUN;
+                state->rle.remain = c - 127;
+            } else {
+                state->rle.mode   = REPEATING_RUN;
+                state->rle.remain = c;
+                state->curr       = qp_stream_get(state->src_stream);
+                if (state->curr < 0) {
+                    break;
+                }
+            }
+        }
 
-bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg) {
-    uint32_t remaining_bytes = byte_count;
-    while (remaining_bytes > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
-            return false;
+        // Copy out as much of the current run as fits
+        uint32_t run = QP_MIN(state->rle.remain, length - count);
+        if (state->rle.mode == REPEATING_RUN) {
+            memset(&output[count], state->curr, run);
+        } else if (qp_stream_read(&output[count], 1, run, state->src_stream) != run) {
+            break;
         }
-        if (!output_callback(byteval, output_arg)) {
-            return false;
+        count += run;
+        state->rle.remain -= run;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
         }
-        remaining_bytes -= 1;
     }
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Progressive pull of bytes, push of pixels
-
-static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
-    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
-    state->curr                           = qp_stream_get(state->src_stream);
-    return state->curr;
+    return count;
 }
 
-static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
-    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
-
-    // Work out if we're parsing the initial marker byte
-    if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
+// Appends a span of palette indices to the pixdata buffer, transmitting the buffer whenever it fills up
+static bool qp_internal_append_indices(qp_internal_pixel_output_state_t* state, uint8_t* palette_indices, uint32_t count) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    while (count > 0) {
+        uint32_t span = QP_MIN(count, state->max_pixels - state->pixel_write_pos);
+        if (!driver->driver_vtable->append_pixels(state->device, state->buffer, qp_internal_global_pixel_lookup_table, state->pixel_write_pos, span, palette_indices)) {
+            return false;
         }
+        state->pixel_write_pos += span;
+        palette_indices += span;
+        count -= span;
 
-        state->curr = qp_stream_get(state->src_stream);
-    }
-
-    // Work out which byte we're returning
-    uint8_t c = state->curr;
-
-    // Decrement the counter of the bytes remaining
-    state->rle.remain--;
-
-    if (state->rle.remain > 0) {
-        // If we're in a non-repeating run, queue up the next byte
-        if (state->rle.mode == NON_REPEATING_RUN) {
-            state->curr = qp_stream_get(state->src_stream);
+        if (state->pixel_write_pos == state->max_pixels) {
+            if (!driver->driver_vtable->pixdata(state->device, state->buffer, state->pixel_write_pos)) {
+                return false;
+            }
+            state->buffer          = qp_internal_next_pixdata_buffer(state->buffer);
+            state->pixel_write_pos = 0;
         }
-    } else {
-        // Swap back to querying the marker byte mode
-        state->rle.mode = MARKER_BYTE;
     }
-
-    return c;
+    return true;
 }
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
-    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
-    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+static bool qp_internal_append_palette_blocks(qp_internal_pixel_output_state_t* output_state, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state) {
+    const uint8_t pixel_bitmask   = (1 << bpp) - 1;
+    const uint8_t pixels_per_byte = 8 / bpp;
+    uint8_t       packed[QP_INTERNAL_DECODE_BLOCK_PIXELS];
+    uint8_t       palette_indices[QP_INTERNAL_DECODE_BLOCK_PIXELS];
 
-    if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos++, 1, &index)) {
-        return false;
-    }
+    while (pixel_count > 0) {
+        uint32_t block_pixels = QP_MIN(pixel_count, QP_INTERNAL_DECODE_BLOCK_PIXELS);
+        uint32_t block_bytes  = (block_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        if (qp_internal_read_block(input_state, packed, block_bytes) != block_bytes) {
+            return false;
+        }
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+        // Unpack the whole block in one go, pixels are stored LSB-first
+        uint8_t* index = palette_indices;
+        for (uint32_t i = 0; i < block_bytes; ++i) {
+            uint8_t byteval = packed[i];
+            for (uint8_t q = 0; q < pixels_per_byte; ++q) {
+                *index++ = byteval & pixel_bitmask;
+                byteval >>= bpp;
+            }
+        }
+
+        if (!qp_internal_append_indices(output_state, palette_indices, block_pixels)) {
             return false;
         }
-        state->pixel_write_pos = 0;
+        pixel_count -= block_pixels;
     }
-
     return true;
 }
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
-    qp_internal_byte_output_state_t* state  = (qp_internal_byte_output_state_t*)cb_arg;
-    painter_driver_t*                driver = (painter_driver_t*)state->device;
-
-    if (!driver->driver_vtable->append_pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos++, byteval)) {
-        return false;
-    }
-
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+// Native pixel data is already in the display's format, so it is decoded straight into the pixdata buffer
+static bool qp_internal_append_native_blocks(qp_internal_byte_output_state_t* state, uint32_t byte_count, qp_internal_byte_input_state_t* input_state) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    while (byte_count > 0) {
+        uint32_t span = QP_MIN(byte_count, state->max_bytes - state->byte_write_pos);
+        if (qp_internal_read_block(input_state, &state->buffer[state->byte_write_pos], span) != span) {
             return false;
         }
-        state->byte_write_pos = 0;
-    }
+        state->byte_write_pos += span;
+        byte_count -= span;
 
+        if (state->byte_write_pos == state->max_bytes) {
+            if (!driver->driver_vtable->pixdata(state->device, state->buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+                return false;
+            }
+            state->buffer         = qp_internal_next_pixdata_buffer(state->buffer);
+            state->byte_write_pos = 0;
+        }
+    }
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+// Helper shared between image and font rendering -- decodes either palette indices or raw native pixels in blocks, and sends them to the display based on the asset's native-ness
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
     bool ret = false;
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Let transmissions run in the background while the next buffer is decoded
+    bool async = qp_comms_async(device, true);
+#endif
+
     // Non-native pixel format
     if (bpp <= 8) {
         // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+        qp_internal_pixel_output_state_t output_state = {.device = device, .buffer = qp_internal_global_pixdata_buffer, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_append_palette_blocks(&output_state, bpp, pixel_count, input_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret &= driver->driver_vtable->pixdata(device, output_state.buffer, output_state.pixel_write_pos);
         }
     }
 
     // Native pixel format
     else if (bpp != driver->native_bits_per_pixel) {
         qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
-        return false;
+        ret = false;
     } else {
         // Set up the output state
-        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+        qp_internal_byte_output_state_t output_state = {.device = device, .buffer = qp_internal_global_pixdata_buffer, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
 
         // Stream the raw pixel data to the display
         uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        ret                 = qp_internal_append_native_blocks(&output_state, byte_count, input_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret &= driver->driver_vtable->pixdata(device, output_state.buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
         }
     }
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Wait for the last transmission, callers are free to reuse the pixdata buffers afterwards
+    if (async) {
+        qp_comms_async(device, false);
+    }
+#endif
+
     return ret;
 }
 
-qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
+bool qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
+    input_state->compression = compression;
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
-            return qp_drawimage_byte_uncompressed_decoder;
+            return true;
         case IMAGE_COMPRESSED_RLE:
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
-            return qp_drawimage_byte_rle_decoder;
+            return true;
         default:
-            return NULL;
+            return false;
     }
 }
@@ -21,6 +21,9 @@ typedef struct qff_font_handle_t {
     bool                  has_palette;
     bool                  is_panel_native;
     painter_compression_t compression_scheme;
+    bool                  unicode_table_sorted; // code points are strictly increasing, so the table can be binary searched
+    uint32_t              unicode_table_offset; // stream position of the first unicode glyph entry
+    uint32_t              glyph_data_offset;    // stream position of the first byte of glyph data
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -36,6 +39,57 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+// Most recently used unicode glyph lookups, most recent first
+typedef struct qff_glyph_cache_entry_t {
+    const qff_font_handle_t *font;
+    uint32_t                 code_point;
+    uint32_t                 value;
+} qff_glyph_cache_entry_t;
+
+static qff_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_SIZE] = {0};
+
+static void qp_glyph_cache_invalidate(const qff_font_handle_t *qff_font) {
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_SIZE; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].font = NULL;
+        }
+    }
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: unicode glyph table access
+
+static bool qp_read_unicode_glyph(qff_font_handle_t *qff_font, uint16_t index, qff_unicode_glyph_v1_t *glyph_info) {
+    if (qp_stream_setpos(&qff_font->stream, qff_font->unicode_table_offset + index * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+        qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+        return false;
+    }
+
+    if (qp_stream_read(glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+        qp_dprintf("Failed to read unicode glyph info\n");
+        return false;
+    }
+
+    return true;
+}
+
+static bool qp_unicode_table_is_sorted(qff_font_handle_t *qff_font) {
+    qff_unicode_glyph_v1_t glyph_info;
+    uint32_t               last_code_point = 0;
+    for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+        if (!qp_read_unicode_glyph(qff_font, i, &glyph_info)) {
+            return false;
+        }
+        if (i > 0 && glyph_info.code_point <= last_code_point) {
+            return false;
+        }
+        last_code_point = glyph_info.code_point;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -100,6 +154,20 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     // Read the info (parsing already successful above, no need to check return value)
     qff_read_font_descriptor(&font->stream, &font->base.line_height, &font->has_ascii_table, &font->num_unicode_glyphs, &font->bpp, &font->has_palette, &font->is_panel_native, &font->compression_scheme, NULL);
 
+    // Work out where the unicode table and glyph data live, so it doesn't need to be done for every glyph
+    font->unicode_table_offset = sizeof(qff_font_descriptor_v1_t)                                      // Skip the font descriptor
+                                 + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
+                                 + sizeof(qgf_block_header_v1_t);                                   // Skip the unicode block header
+
+    font->glyph_data_offset = sizeof(qff_font_descriptor_v1_t)                                                                                                         // Skip the font descriptor
+                              + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                       // Skip the ascii table
+                              + (font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                              + (font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                             // Skip the palette
+                              + sizeof(qgf_block_header_v1_t);                                                                                                       // Skip the data block header
+
+    // Fonts generated by older tooling may not have their unicode table in code point order, fall back to a linear search for those
+    font->unicode_table_sorted = qp_unicode_table_is_sorted(font);
+
     if (!qp_internal_bpp_capable(font->bpp)) {
         qp_dprintf("qp_load_font: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)font->bpp);
         qp_close_font((painter_font_handle_t)font);
@@ -151,6 +219,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Forget any lookups for this font, the slot may be reused by another one
+    qp_glyph_cache_invalidate(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -214,7 +287,76 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
+// Finds the glyph information for a code point in the unicode table
+static bool qp_drawtext_find_unicode_glyph(qff_font_handle_t *qff_font, uint32_t code_point, uint32_t *value) {
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_SIZE; ++i) {
+        if (glyph_cache[i].font == qff_font && glyph_cache[i].code_point == code_point) {
+            // Move the entry to the front, so that the least recently used one is always at the back
+            qff_glyph_cache_entry_t entry = glyph_cache[i];
+            memmove(&glyph_cache[1], &glyph_cache[0], i * sizeof(qff_glyph_cache_entry_t));
+            glyph_cache[0] = entry;
+            *value         = entry.value;
+            return true;
+        }
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    qff_unicode_glyph_v1_t glyph_info;
+    bool                   found = false;
+    if (qff_font->unicode_table_sorted) {
+        uint16_t lo = 0;
+        uint16_t hi = qff_font->num_unicode_glyphs;
+        while (lo < hi) {
+            uint16_t mid = lo + (hi - lo) / 2;
+            if (!qp_read_unicode_glyph(qff_font, mid, &glyph_info)) {
+                return false;
+            }
+            if (glyph_info.code_point == code_point) {
+                found = true;
+                break;
+            } else if (glyph_info.code_point < code_point) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+    } else {
+        if (qp_stream_setpos(&qff_font->stream, qff_font->unicode_table_offset) < 0) {
+            qp_dprintf("Failed to set stream position while preparing glyph data\n");
+            return false;
+        }
+
+        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+                qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+                return false;
+            }
+
+            if (glyph_info.code_point == code_point) {
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (!found) {
+        qp_dprintf("Failed to find unicode glyph info\n");
+        return false;
+    }
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Evict the least recently used entry
+    memmove(&glyph_cache[1], &glyph_cache[0], (QUANTUM_PAINTER_GLYPH_CACHE_SIZE - 1) * sizeof(qff_glyph_cache_entry_t));
+    glyph_cache[0] = (qff_glyph_cache_entry_t){.font = qff_font, .code_point = code_point, .value = glyph_info.value};
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    *value = glyph_info.value;
+    return true;
+}
+
 static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    uint32_t value;
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
         qff_ascii_glyph_v1_t glyph_info;
@@ -231,65 +373,23 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        value = glyph_info.value;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
-        uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
-                                     + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
-                                     + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
-
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        if (!qp_drawtext_find_unicode_glyph(qff_font, code_point, &value)) {
             return false;
         }
+    }
 
-        qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
-            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
-                qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
-                return false;
-            }
-
-            if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
-            }
-        }
-
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
+    uint8_t  glyph_width  = (uint8_t)(value & QFF_GLYPH_WIDTH_MASK);
+    uint32_t glyph_offset = ((value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    if (qp_stream_setpos(&qff_font->stream, qff_font->glyph_data_offset + glyph_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
         return false;
     }
-    return false;
+
+    *width = glyph_width;
+    return true;
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
@@ -342,7 +442,6 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
@@ -366,7 +465,7 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
-    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
+    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -417,9 +516,8 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     }
 
     // Set up the byte input state and input callback
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
-    if (input_callback == NULL) {
+    qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = &qff_font->stream};
+    if (!qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme)) {
         qp_dprintf("qp_drawtext_recolor: fail (invalid font compression scheme)\n");
         qp_comms_stop(device);
         return false;
@@ -434,8 +532,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .xpos   = x,
                                                .ypos   = y,
                                                // Input
-                                               .input_callback = input_callback,
-                                               .input_state    = &input_state,
+                                               .input_state = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+
+// Deliberately not a multiple of the decode block size, so that blocks straddle transmissions
+#define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 100
+#define QUANTUM_PAINTER_SUPPORTS_256_PALETTE 1
+#define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS 1
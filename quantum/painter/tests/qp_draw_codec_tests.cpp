@@ -0,0 +1,154 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "qp_internal.h"
+#include "qp_draw.h"
+#include "qp_stream.h"
+}
+
+extern "C" {
+__attribute__((__aligned__(4))) uint8_t    qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+__attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[256];
+
+uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
+}
+}
+
+// Everything sent to the display, in order
+static std::vector<uint8_t> transmitted;
+
+// Stores the hue of each palette entry, one byte per pixel
+static bool mock_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        target_buffer[pixel_offset + i] = palette[palette_indices[i]].hsv888.h;
+    }
+    return true;
+}
+
+static bool mock_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+static bool mock_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    const uint8_t    *data   = (const uint8_t *)pixel_data;
+    transmitted.insert(transmitted.end(), data, data + native_pixel_count * driver->native_bits_per_pixel / 8);
+    return true;
+}
+
+static const painter_driver_vtable_t mock_vtable = {
+    .pixdata        = mock_pixdata,
+    .append_pixels  = mock_append_pixels,
+    .append_pixdata = mock_append_pixdata,
+};
+
+class QPDrawCodec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        transmitted.clear();
+        for (int i = 0; i < 256; ++i) {
+            qp_internal_global_pixel_lookup_table[i].hsv888.h = (uint8_t)(i * 7 + 3);
+        }
+        memset(&driver, 0, sizeof(driver));
+        driver.driver_vtable = &mock_vtable;
+    }
+
+    // Random bytes, optionally RLE-encoded with runs of random lengths; returns the encoded stream
+    std::vector<uint8_t> make_stream(painter_compression_t compression, uint32_t decoded_length) {
+        std::vector<uint8_t> stream;
+        while (decoded.size() < decoded_length) {
+            if (compression == IMAGE_UNCOMPRESSED) {
+                decoded.push_back(rng());
+                stream.push_back(decoded.back());
+            } else if (rng() & 1) {
+                uint8_t run   = 1 + rng() % 127;
+                uint8_t value = rng();
+                stream.push_back(run);
+                stream.push_back(value);
+                decoded.insert(decoded.end(), run, value);
+            } else {
+                uint8_t run = 1 + rng() % 128;
+                stream.push_back(run + 127);
+                for (uint8_t i = 0; i < run; ++i) {
+                    stream.push_back(rng());
+                    decoded.push_back(stream.back());
+                }
+            }
+        }
+        return stream;
+    }
+
+    // What a pixel-at-a-time decoder produces from the decoded bytes
+    std::vector<uint8_t> reference_pixels(uint8_t bpp, uint32_t pixel_count) {
+        std::vector<uint8_t> pixels;
+        if (bpp > 8) {
+            pixels.assign(decoded.begin(), decoded.begin() + pixel_count * bpp / 8);
+            return pixels;
+        }
+        const uint8_t pixels_per_byte = 8 / bpp;
+        for (uint32_t i = 0; i < pixel_count; ++i) {
+            uint8_t index = (decoded[i / pixels_per_byte] >> ((i % pixels_per_byte) * bpp)) & ((1 << bpp) - 1);
+            pixels.push_back(qp_internal_global_pixel_lookup_table[index].hsv888.h);
+        }
+        return pixels;
+    }
+
+    void check(uint8_t bpp, painter_compression_t compression, uint32_t pixel_count) {
+        driver.native_bits_per_pixel = bpp > 8 ? bpp : 8;
+        transmitted.clear();
+        decoded.clear();
+
+        uint32_t             byte_count = bpp > 8 ? pixel_count * bpp / 8 : (pixel_count * bpp + 7) / 8;
+        std::vector<uint8_t> data       = make_stream(compression, byte_count);
+        qp_memory_stream_t   stream     = qp_make_memory_stream(data.data(), data.size());
+
+        qp_internal_byte_input_state_t input_state = {.device = &driver, .src_stream = (qp_stream_t *)&stream};
+        ASSERT_TRUE(qp_internal_prepare_input_state(&input_state, compression));
+        ASSERT_TRUE(qp_internal_appender(&driver, bpp, pixel_count, &input_state));
+
+        EXPECT_EQ(transmitted, reference_pixels(bpp, pixel_count)) << (int)bpp << "bpp, " << (compression == IMAGE_COMPRESSED_RLE ? "RLE" : "raw") << ", " << pixel_count << " pixels";
+    }
+
+    painter_driver_t     driver;
+    std::vector<uint8_t> decoded;
+    std::minstd_rand     rng{1234};
+};
+
+TEST_F(QPDrawCodec, PaletteBlocksMatchPerPixelDecoding) {
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        for (painter_compression_t compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            for (uint32_t pixel_count : {1u, 7u, 63u, 64u, 65u, 100u, 1000u, 2003u}) {
+                check(bpp, compression, pixel_count);
+            }
+        }
+    }
+}
+
+TEST_F(QPDrawCodec, NativeBlocksMatchPerPixelDecoding) {
+    for (uint8_t bpp : {16, 24}) {
+        for (painter_compression_t compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            for (uint32_t pixel_count : {1u, 33u, 50u, 51u, 1000u}) {
+                check(bpp, compression, pixel_count);
+            }
+        }
+    }
+}
+
+TEST_F(QPDrawCodec, TruncatedInputFails) {
+    driver.native_bits_per_pixel = 8;
+    std::vector<uint8_t> data    = make_stream(IMAGE_UNCOMPRESSED, 10);
+    qp_memory_stream_t   stream  = qp_make_memory_stream(data.data(), data.size());
+
+    qp_internal_byte_input_state_t input_state = {.device = &driver, .src_stream = (qp_stream_t *)&stream};
+    ASSERT_TRUE(qp_internal_prepare_input_state(&input_state, IMAGE_UNCOMPRESSED));
+    EXPECT_FALSE(qp_internal_appender(&driver, 8, 11, &input_state));
+}
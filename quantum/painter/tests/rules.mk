@@ -0,0 +1,8 @@
+qp_draw_codec_DEFS := -DQUANTUM_PAINTER_ENABLE -DEEPROM_TEST_HARNESS
+qp_draw_codec_INC := $(QUANTUM_PATH)/painter
+qp_draw_codec_CONFIG := $(QUANTUM_PATH)/painter/tests/config_mock.h
+
+qp_draw_codec_SRC := \
+	$(QUANTUM_PATH)/painter/tests/qp_draw_codec_tests.cpp \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c
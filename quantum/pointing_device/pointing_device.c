@@ -17,6 +17,7 @@
  */
 
 #include "pointing_device.h"
+#include <stdlib.h>
 #include <string.h>
 #include "timer.h"
 #include "gpio.h"
@@ -25,6 +26,21 @@
 #    include "mousekey.h"
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    if !defined(POINTING_DEVICE_MOTION_PIN)
+#        error "POINTING_DEVICE_MOTION_INTERRUPT requires POINTING_DEVICE_MOTION_PIN to be defined"
+#    endif
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "POINTING_DEVICE_MOTION_INTERRUPT is only supported on ChibiOS"
+#    endif
+#    include <ch.h>
+#    include <hal.h>
+#    include "pointing_device_accumulator.h"
+#    if !defined(PAL_USE_CALLBACKS) || (PAL_USE_CALLBACKS != TRUE)
+#        error "POINTING_DEVICE_MOTION_INTERRUPT requires PAL_USE_CALLBACKS to be enabled in halconf.h"
+#    endif
+#endif
+
 #if (defined(POINTING_DEVICE_ROTATION_90) + defined(POINTING_DEVICE_ROTATION_180) + defined(POINTING_DEVICE_ROTATION_270)) > 1
 #    error More than one rotation selected.  This is not supported.
 #endif
@@ -79,6 +95,29 @@ uint16_t pointing_device_get_shared_cpi(void) {
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
 
+#if defined(POINTING_DEVICE_MOTION_SCALE) || defined(POINTING_DEVICE_ACCEL_CURVE)
+#    define POINTING_DEVICE_MOTION_PIPELINE
+#    ifndef POINTING_DEVICE_MOTION_SCALE
+#        define POINTING_DEVICE_MOTION_SCALE 256
+#    endif
+#    ifndef POINTING_DEVICE_ACCEL_STEP
+#        define POINTING_DEVICE_ACCEL_STEP 8
+#    endif
+// Motion left over for later reports is capped, so that a burst of oversized deltas doesn't keep the cursor moving for long
+#    define POINTING_DEVICE_MOTION_MAX_REMAINDER ((int32_t)XY_REPORT_MAX * 256 * 4)
+
+// Motion in 1/256th counts that hasn't made it into a report yet
+typedef struct {
+    int32_t x;
+    int32_t y;
+} pointing_device_motion_remainder_t;
+
+static pointing_device_motion_remainder_t local_motion_remainder = {0};
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+static pointing_device_motion_remainder_t shared_motion_remainder = {0};
+#    endif
+#endif
+
 #define POINTING_DEVICE_DRIVER_CONCAT(name) name##_pointing_device_driver
 #define POINTING_DEVICE_DRIVER(name) POINTING_DEVICE_DRIVER_CONCAT(name)
 
@@ -102,6 +141,138 @@ const pointing_device_driver_t custom_pointing_device_driver = {
 
 const pointing_device_driver_t *pointing_device_driver = &POINTING_DEVICE_DRIVER(POINTING_DEVICE_DRIVER_NAME);
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+#        define POINTING_DEVICE_MOTION_EVENT_MODE PAL_EVENT_MODE_FALLING_EDGE
+#        define pointing_device_motion_active() (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+#    else
+#        define POINTING_DEVICE_MOTION_EVENT_MODE PAL_EVENT_MODE_RISING_EDGE
+#        define pointing_device_motion_active() (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+#    endif
+
+// Drivers are still read this often without motion, e.g. for gestures that keep generating reports
+#    ifndef POINTING_DEVICE_MOTION_POLL_INTERVAL
+#        define POINTING_DEVICE_MOTION_POLL_INTERVAL 10
+#    endif
+#    if POINTING_DEVICE_MOTION_POLL_INTERVAL > 0
+#        define POINTING_DEVICE_MOTION_TIMEOUT TIME_MS2I(POINTING_DEVICE_MOTION_POLL_INTERVAL)
+#    elif defined(POINTING_DEVICE_GESTURES_CURSOR_GLIDE_ENABLE)
+#        error "POINTING_DEVICE_MOTION_POLL_INTERVAL must not be 0 when using inertial cursor. Need repeated calls to get_report() to generate glide events."
+#    else
+#        define POINTING_DEVICE_MOTION_TIMEOUT TIME_INFINITE
+#    endif
+
+// Above the main loop, so that a motion edge preempts it, but below the split transport threads
+#    ifndef POINTING_DEVICE_MOTION_THREAD_PRIORITY
+#        define POINTING_DEVICE_MOTION_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+
+static pointing_device_accumulator_t pointing_device_motion = {0};
+
+// Set once the motion line's EXTI channel has been claimed, otherwise the line is checked every millisecond instead
+static bool pointing_device_motion_event = false;
+
+static MUTEX_DECL(pointing_device_driver_mutex);
+static BSEMAPHORE_DECL(pointing_device_motion_sem, true);
+static THD_WORKING_AREA(waPointingDeviceMotionThread, 512);
+
+/**
+ * @brief Serialises access to the pointing device driver between the sampling thread and the main thread
+ */
+void pointing_device_driver_lock(void) {
+    chMtxLock(&pointing_device_driver_mutex);
+}
+
+void pointing_device_driver_unlock(void) {
+    chMtxUnlock(&pointing_device_driver_mutex);
+}
+
+static void pointing_device_motion_cb(void *arg) {
+    chSysLockFromISR();
+    chBSemSignalI(&pointing_device_motion_sem);
+    chSysUnlockFromISR();
+}
+
+// Waits until the motion line is asserted, or until the driver is due to be polled anyway
+static void pointing_device_motion_wait(uint32_t last_read) {
+    // The motion line stays asserted until the sensor has been read, so only wait for an edge once it is released
+    if (pointing_device_motion_event) {
+        if (!pointing_device_motion_active()) {
+            chBSemWaitTimeout(&pointing_device_motion_sem, POINTING_DEVICE_MOTION_TIMEOUT);
+        }
+        return;
+    }
+
+    while (!pointing_device_motion_active()) {
+#    if POINTING_DEVICE_MOTION_POLL_INTERVAL > 0
+        if (timer_elapsed32(last_read) >= POINTING_DEVICE_MOTION_POLL_INTERVAL) {
+            return;
+        }
+#    endif
+        chThdSleepMilliseconds(1);
+    }
+}
+
+static THD_FUNCTION(PointingDeviceMotionThread, arg) {
+    report_mouse_t sample    = {0};
+    uint32_t       last_read = timer_read32();
+
+    chRegSetThreadName("pointing");
+    while (true) {
+        pointing_device_motion_wait(last_read);
+        systime_t start = chVTGetSystemTimeX();
+
+        pointing_device_driver_lock();
+        sample    = pointing_device_driver->get_report(sample);
+        last_read = timer_read32();
+        pointing_device_driver_unlock();
+
+        chSysLock();
+        pointing_device_accumulator_add(&pointing_device_motion, sample);
+        chSysUnlock();
+
+        sample.x = sample.y = sample.v = sample.h = 0;
+
+        // Reports go out at most every millisecond, so leave the main loop the rest of it if the sensor keeps reporting motion
+        chThdSleepUntilWindowed(start, chTimeAddX(start, TIME_MS2I(1)));
+    }
+}
+
+static void pointing_device_motion_init(void) {
+    // Lines with the same pad number share an EXTI channel, leave it alone if something else already uses it
+    palevent_t *event = palGetLineEvent(POINTING_DEVICE_MOTION_PIN);
+    if (event->cb == NULL) {
+        palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, POINTING_DEVICE_MOTION_EVENT_MODE);
+        palSetLineCallback(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_cb, NULL);
+        pointing_device_motion_event = true;
+    }
+    chThdCreateStatic(waPointingDeviceMotionThread, sizeof(waPointingDeviceMotionThread), POINTING_DEVICE_MOTION_THREAD_PRIORITY, PointingDeviceMotionThread, NULL);
+}
+
+/**
+ * @brief Adds the motion accumulated by the sampling thread to a mouse report
+ *
+ * Motion that doesn't fit into the report is kept for the next one. Buttons the sensor changed since the last report
+ * are applied, any other buttons are left as they are.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_INTERRUPT
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the accumulated motion added
+ */
+report_mouse_t pointing_device_motion_get_report(report_mouse_t mouse_report) {
+    chSysLock();
+    mouse_report = pointing_device_accumulator_take(&pointing_device_motion, mouse_report);
+    chSysUnlock();
+
+    return mouse_report;
+}
+
+#    define pointing_device_read_sensor(mouse_report) pointing_device_motion_get_report(mouse_report)
+#else
+#    define pointing_device_read_sensor(mouse_report) pointing_device_driver->get_report(mouse_report)
+#endif
+
 /**
  * @brief Keyboard level code pointing device initialisation
  *
@@ -174,9 +345,19 @@ __attribute__((weak)) void pointing_device_init(void) {
 #    else
         gpio_set_pin_input(POINTING_DEVICE_MOTION_PIN);
 #    endif
+#endif
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+        pointing_device_motion_init();
 #endif
     }
 
+#ifdef POINTING_DEVICE_MOTION_PIPELINE
+    memset(&local_motion_remainder, 0, sizeof(local_motion_remainder));
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+    memset(&shared_motion_remainder, 0, sizeof(shared_motion_remainder));
+#    endif
+#endif
+
     pointing_device_init_kb();
     pointing_device_init_user();
 }
@@ -239,6 +420,81 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+#ifdef POINTING_DEVICE_MOTION_PIPELINE
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+static const uint16_t pointing_device_accel_curve[] = POINTING_DEVICE_ACCEL_CURVE;
+
+/**
+ * @brief Looks up the gain for a speed in the acceleration curve
+ *
+ * The curve has a point every POINTING_DEVICE_ACCEL_STEP counts per report, speeds in between are interpolated linearly
+ * and speeds past the last point use its gain.
+ *
+ * @param[in] speed counts per report
+ * @return gain in 1/256ths
+ */
+static int32_t pointing_device_accel_gain(uint32_t speed) {
+    uint32_t index = speed / POINTING_DEVICE_ACCEL_STEP;
+    if (index >= ARRAY_SIZE(pointing_device_accel_curve) - 1) {
+        return pointing_device_accel_curve[ARRAY_SIZE(pointing_device_accel_curve) - 1];
+    }
+
+    int32_t low  = pointing_device_accel_curve[index];
+    int32_t high = pointing_device_accel_curve[index + 1];
+    return low + (high - low) * (int32_t)(speed % POINTING_DEVICE_ACCEL_STEP) / POINTING_DEVICE_ACCEL_STEP;
+}
+#    endif
+
+/**
+ * @brief Takes whole counts that fit into a report out of a motion remainder
+ *
+ * @param[in] remainder motion in 1/256th counts, reduced by what was taken
+ * @return mouse_xy_report_t whole counts
+ */
+static inline mouse_xy_report_t pointing_device_motion_take(int32_t *remainder) {
+    // Division truncates towards zero, so the fraction that is left keeps its sign
+    int32_t counts = CONSTRAIN_HID_XY(*remainder / 256);
+
+    *remainder -= counts * 256;
+    if (*remainder > POINTING_DEVICE_MOTION_MAX_REMAINDER) {
+        *remainder = POINTING_DEVICE_MOTION_MAX_REMAINDER;
+    } else if (*remainder < -POINTING_DEVICE_MOTION_MAX_REMAINDER) {
+        *remainder = -POINTING_DEVICE_MOTION_MAX_REMAINDER;
+    }
+    return counts;
+}
+
+/**
+ * @brief Scales and accelerates the motion of a mouse report in fixed point
+ *
+ * The motion is scaled by POINTING_DEVICE_MOTION_SCALE and the gain of POINTING_DEVICE_ACCEL_CURVE. Fractions of a count
+ * and motion that doesn't fit into the report are carried over to the next report instead of being dropped.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @param[in] remainder motion carried over between reports
+ * @return report_mouse_t with scaled motion
+ */
+static report_mouse_t pointing_device_motion_pipeline(report_mouse_t mouse_report, pointing_device_motion_remainder_t *remainder) {
+    int32_t gain = POINTING_DEVICE_MOTION_SCALE;
+
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+    uint32_t dx = abs(mouse_report.x);
+    uint32_t dy = abs(mouse_report.y);
+
+    // Cheap approximation of the length of the motion vector, within 12% of it
+    uint32_t speed = MAX(dx, dy) + MIN(dx, dy) / 2;
+    gain           = gain * pointing_device_accel_gain(speed) / 256;
+#    endif
+
+    remainder->x += mouse_report.x * gain;
+    remainder->y += mouse_report.y * gain;
+
+    mouse_report.x = pointing_device_motion_take(&remainder->x);
+    mouse_report.y = pointing_device_motion_take(&remainder->y);
+    return mouse_report;
+}
+#endif
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -263,7 +519,7 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_MOTION_INTERRUPT)
 #    if defined(SPLIT_POINTING_ENABLE)
 #        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #    endif
@@ -279,18 +535,18 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
-        local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
+        local_mouse_report         = pointing_device_read_sensor(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
 #    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
-        local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+        local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_read_sensor(local_mouse_report) : shared_mouse_report;
 #    else
 #        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
 #    endif
 #else
-    local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
+    local_mouse_report = pointing_device_read_sensor(local_mouse_report);
 #endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_MOTION_INTERRUPT)
     }
 #endif
 
@@ -303,9 +559,16 @@ __attribute__((weak)) bool pointing_device_task(void) {
         local_mouse_report  = pointing_device_adjust_by_defines_right(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines(shared_mouse_report);
     }
+#    ifdef POINTING_DEVICE_MOTION_PIPELINE
+    local_mouse_report  = pointing_device_motion_pipeline(local_mouse_report, &local_motion_remainder);
+    shared_mouse_report = pointing_device_motion_pipeline(shared_mouse_report, &shared_motion_remainder);
+#    endif
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#    ifdef POINTING_DEVICE_MOTION_PIPELINE
+    local_mouse_report = pointing_device_motion_pipeline(local_mouse_report, &local_motion_remainder);
+#    endif
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
 #endif
     // automatic mouse layer function
@@ -352,10 +615,14 @@ void pointing_device_set_report(report_mouse_t mouse_report) {
  */
 uint16_t pointing_device_get_cpi(void) {
 #if defined(SPLIT_POINTING_ENABLE)
-    return POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_cpi() : shared_cpi;
-#else
-    return pointing_device_driver->get_cpi();
+    if (!(POINTING_DEVICE_THIS_SIDE)) {
+        return shared_cpi;
+    }
 #endif
+    pointing_device_driver_lock();
+    uint16_t cpi = pointing_device_driver->get_cpi();
+    pointing_device_driver_unlock();
+    return cpi;
 }
 
 /**
@@ -367,14 +634,14 @@ uint16_t pointing_device_get_cpi(void) {
  */
 void pointing_device_set_cpi(uint16_t cpi) {
 #if defined(SPLIT_POINTING_ENABLE)
-    if (POINTING_DEVICE_THIS_SIDE) {
-        pointing_device_driver->set_cpi(cpi);
-    } else {
+    if (!(POINTING_DEVICE_THIS_SIDE)) {
         shared_cpi = cpi;
+        return;
     }
-#else
-    pointing_device_driver->set_cpi(cpi);
 #endif
+    pointing_device_driver_lock();
+    pointing_device_driver->set_cpi(cpi);
+    pointing_device_driver_unlock();
 }
 
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
@@ -391,7 +658,9 @@ void pointing_device_set_cpi(uint16_t cpi) {
 void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
     bool local = (is_keyboard_left() == left);
     if (local) {
+        pointing_device_driver_lock();
         pointing_device_driver->set_cpi(cpi);
+        pointing_device_driver_unlock();
     } else {
         shared_cpi = cpi;
     }
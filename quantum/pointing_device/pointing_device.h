@@ -130,6 +130,15 @@ uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, poi
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+void           pointing_device_driver_lock(void);
+void           pointing_device_driver_unlock(void);
+report_mouse_t pointing_device_motion_get_report(report_mouse_t mouse_report);
+#else
+#    define pointing_device_driver_lock()
+#    define pointing_device_driver_unlock()
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pointing_device.h"
+#include "pointing_device_accumulator.h"
+
+void pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample) {
+    accumulator->x += sample.x;
+    accumulator->y += sample.y;
+    accumulator->v += sample.v;
+    accumulator->h += sample.h;
+    accumulator->pressed |= sample.buttons & ~accumulator->buttons;
+    accumulator->buttons = sample.buttons;
+}
+
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report) {
+    int32_t x = CONSTRAIN_HID_XY(accumulator->x + mouse_report.x);
+    int32_t y = CONSTRAIN_HID_XY(accumulator->y + mouse_report.y);
+    int32_t v = accumulator->v + mouse_report.v;
+    int32_t h = accumulator->h + mouse_report.h;
+
+    v = v < HV_REPORT_MIN ? HV_REPORT_MIN : (v > HV_REPORT_MAX ? HV_REPORT_MAX : v);
+    h = h < HV_REPORT_MIN ? HV_REPORT_MIN : (h > HV_REPORT_MAX ? HV_REPORT_MAX : h);
+
+    // Whatever didn't fit is kept for the next report
+    accumulator->x -= x - mouse_report.x;
+    accumulator->y -= y - mouse_report.y;
+    accumulator->v -= v - mouse_report.v;
+    accumulator->h -= h - mouse_report.h;
+
+    // Taps shorter than a report still show up as pressed for one report
+    uint8_t buttons = accumulator->buttons | accumulator->pressed;
+    uint8_t changed = (accumulator->buttons ^ accumulator->reported) | accumulator->pressed;
+
+    accumulator->pressed  = 0;
+    accumulator->reported = buttons;
+
+    mouse_report.buttons = (mouse_report.buttons & ~changed) | (buttons & changed);
+    mouse_report.x       = x;
+    mouse_report.y       = y;
+    mouse_report.v       = v;
+    mouse_report.h       = h;
+    return mouse_report;
+}
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "report.h"
+
+// Motion read from the sensor that hasn't made it into a report yet
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t v;
+    int32_t h;
+    uint8_t buttons;  // current button state of the sensor
+    uint8_t pressed;  // buttons pressed by the sensor since the last report
+    uint8_t reported; // button state of the sensor as of the last report
+} pointing_device_accumulator_t;
+
+// Adds a report read from the sensor
+void pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample);
+
+// Moves as much of the accumulated motion into the report as fits, along with any buttons the sensor changed
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report);
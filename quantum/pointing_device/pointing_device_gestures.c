@@ -18,7 +18,7 @@
 #include "timer.h"
 
 #ifdef POINTING_DEVICE_GESTURES_CURSOR_GLIDE_ENABLE
-#    ifdef POINTING_DEVICE_MOTION_PIN
+#    if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_MOTION_INTERRUPT)
 #        error POINTING_DEVICE_MOTION_PIN not supported when using inertial cursor. Need repeated calls to get_report() to generate glide events.
 #    endif
 
@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "pointing_device.h"
+#include "pointing_device_accumulator.h"
+}
+
+class PointingDeviceAccumulator : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        accumulator = {};
+    }
+
+    void add(int16_t x, int16_t y, uint8_t buttons = 0) {
+        report_mouse_t sample = {};
+        sample.x              = x;
+        sample.y              = y;
+        sample.buttons        = buttons;
+        pointing_device_accumulator_add(&accumulator, sample);
+    }
+
+    report_mouse_t take(uint8_t buttons = 0) {
+        report_mouse_t mouse_report = {};
+        mouse_report.buttons        = buttons;
+        return pointing_device_accumulator_take(&accumulator, mouse_report);
+    }
+
+    pointing_device_accumulator_t accumulator;
+};
+
+TEST_F(PointingDeviceAccumulator, SamplesAreSummed) {
+    add(3, -4);
+    add(5, -6);
+    report_mouse_t report = take();
+    EXPECT_EQ(report.x, 8);
+    EXPECT_EQ(report.y, -10);
+
+    report = take();
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, OverflowCarriesOver) {
+    add(100, -100);
+    add(100, -100);
+    report_mouse_t report = take();
+    EXPECT_EQ(report.x, XY_REPORT_MAX);
+    EXPECT_EQ(report.y, XY_REPORT_MIN);
+
+    report = take();
+    EXPECT_EQ(report.x, 200 - XY_REPORT_MAX);
+    EXPECT_EQ(report.y, -200 - XY_REPORT_MIN);
+
+    report = take();
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, ReportMotionIsIncluded) {
+    add(10, 10);
+    report_mouse_t mouse_report = {};
+    mouse_report.x              = XY_REPORT_MAX - 5;
+    report_mouse_t report       = pointing_device_accumulator_take(&accumulator, mouse_report);
+    EXPECT_EQ(report.x, XY_REPORT_MAX);
+    EXPECT_EQ(report.y, 10);
+
+    // Only the sensor's share of the motion is carried over
+    report = take();
+    EXPECT_EQ(report.x, 5);
+    EXPECT_EQ(report.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, ShortTapIsReportedOnce) {
+    add(0, 0, MOUSE_BTN1);
+    add(0, 0, 0);
+    EXPECT_EQ(take().buttons, MOUSE_BTN1);
+    EXPECT_EQ(take().buttons, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, HeldButtonIsKept) {
+    add(0, 0, MOUSE_BTN1);
+    EXPECT_EQ(take().buttons, MOUSE_BTN1);
+    EXPECT_EQ(take(MOUSE_BTN1).buttons, MOUSE_BTN1);
+
+    add(0, 0, 0);
+    EXPECT_EQ(take(MOUSE_BTN1).buttons, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, OtherButtonsAreLeftAlone) {
+    // Buttons set from keycodes stay as they are unless the sensor changes them
+    EXPECT_EQ(take(MOUSE_BTN2).buttons, MOUSE_BTN2);
+
+    add(0, 0, MOUSE_BTN1);
+    EXPECT_EQ(take(MOUSE_BTN2).buttons, MOUSE_BTN1 | MOUSE_BTN2);
+}
@@ -0,0 +1,7 @@
+pointing_device_accumulator_DEFS := -DPOINTING_DEVICE_ENABLE -DMOUSE_ENABLE
+pointing_device_accumulator_INC := $(QUANTUM_PATH)/pointing_device
+pointing_device_accumulator_CONFIG := $(QUANTUM_PATH)/pointing_device/tests/config_mock.h
+
+pointing_device_accumulator_SRC := \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_accumulator_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_accumulator.c
@@ -0,0 +1,2 @@
+TEST_LIST += \
+	pointing_device_accumulator
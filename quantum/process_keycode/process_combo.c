@@ -422,6 +422,83 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Index of (keycode, combo index) pairs, sorted by keycode and then by combo
+ * index, so that a key event only visits the combos containing that key, in
+ * the same order as a linear scan would. */
+static uint16_t combo_key_index_keycodes[COMBO_KEY_INDEX_LENGTH];
+static uint16_t combo_key_index_combos[COMBO_KEY_INDEX_LENGTH];
+static uint16_t combo_key_index_size  = 0;
+static uint16_t combo_key_index_count = 0;
+static bool     combo_key_index_valid = false;
+static bool     combo_key_index_built = false;
+
+void combo_key_index_invalidate(void) {
+    combo_key_index_built = false;
+}
+
+static void combo_key_index_build(void) {
+    combo_key_index_count = combo_count();
+    combo_key_index_size  = 0;
+    combo_key_index_valid = true;
+    combo_key_index_built = true;
+
+    for (uint16_t combo_index = 0; combo_index < combo_key_index_count; ++combo_index) {
+        const uint16_t *keys = combo_get(combo_index)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            /* Keys listed twice in one combo must still only visit it once */
+            bool duplicate = false;
+            for (uint8_t j = 0; j < i; ++j) {
+                if (pgm_read_word(&keys[j]) == key) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (duplicate) {
+                continue;
+            }
+
+            if (combo_key_index_size >= COMBO_KEY_INDEX_LENGTH) {
+                /* Doesn't fit, fall back to scanning every combo */
+                combo_key_index_valid = false;
+                return;
+            }
+
+            /* Insertion sort; combo indices are visited in order so equal keycodes stay sorted by combo */
+            uint16_t pos = combo_key_index_size++;
+            for (; pos > 0 && combo_key_index_keycodes[pos - 1] > key; --pos) {
+                combo_key_index_keycodes[pos] = combo_key_index_keycodes[pos - 1];
+                combo_key_index_combos[pos]   = combo_key_index_combos[pos - 1];
+            }
+            combo_key_index_keycodes[pos] = key;
+            combo_key_index_combos[pos]   = combo_index;
+        }
+    }
+}
+
+static inline bool combo_key_index_ready(void) {
+    if (!combo_key_index_built || combo_key_index_count != combo_count()) {
+        combo_key_index_build();
+    }
+    return combo_key_index_valid;
+}
+
+/* Returns the position of the first index entry for keycode, if any. */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_key_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_key_index_keycodes[mid] < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
     uint8_t  key_count = 0;
     uint16_t key_index = -1;
@@ -581,10 +658,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX_LENGTH
+    /* COMBO_END matches the terminator of every combo, so it has to take the slow path. */
+    if (keycode != COMBO_END && combo_key_index_ready()) {
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index_keycodes[i] == keycode; ++i) {
+            uint16_t idx = combo_key_index_combos[i];
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -647,7 +735,16 @@ void combo_task(void) {
 #endif
 }
 
+void combo_init(void) {
+#ifdef COMBO_KEY_INDEX_LENGTH
+    combo_key_index_build();
+#endif
+}
+
 void combo_enable(void) {
+#ifdef COMBO_KEY_INDEX_LENGTH
+    combo_key_index_ready();
+#endif
     b_combo_enable = true;
 }
 
@@ -73,10 +73,15 @@ typedef struct combo_t {
 /* check if keycode is only modifiers */
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
+void combo_init(void);
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+void combo_key_index_invalidate(void);
+#endif
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
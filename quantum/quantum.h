@@ -244,6 +244,10 @@ extern layer_state_t layer_state;
 #    include "layer_lock.h"
 #endif
 
+#ifdef SCAN_PROFILER_ENABLE
+#    include "scan_profiler.h"
+#endif
+
 #ifdef COMMUNITY_MODULES_ENABLE
 #    include "community_modules.h"
 #endif
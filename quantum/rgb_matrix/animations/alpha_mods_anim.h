@@ -4,6 +4,7 @@ RGB_MATRIX_EFFECT(ALPHAS_MODS)
 
 // alphas = color1, mods = color2
 bool ALPHAS_MODS(effect_params_t* params) {
+    if (rgb_matrix_frame_unchanged(params)) return false;
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     hsv_t hsv  = rgb_matrix_config.hsv;
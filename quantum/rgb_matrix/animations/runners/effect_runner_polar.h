@@ -0,0 +1,54 @@
+#pragma once
+
+typedef hsv_t (*polar_f)(hsv_t hsv, uint8_t dist, uint8_t angle, uint8_t time);
+
+bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        led_polar_t polar = rgb_matrix_led_polar(i);
+        rgb_t       rgb   = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, polar.dist, polar.angle, time));
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#ifdef RGB_MATRIX_LED_TABLES
+// Both values come from the generated table, so there is nothing to save by only using one of them
+#    define effect_runner_polar_dist effect_runner_polar
+#    define effect_runner_polar_angle effect_runner_polar
+#else
+// Without the table, only compute what the effect uses; the other argument is passed as 0
+
+bool effect_runner_polar_dist(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        int16_t dx   = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy   = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        uint8_t dist = sqrt16(dx * dx + dy * dy);
+        rgb_t   rgb  = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, dist, 0, time));
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+bool effect_runner_polar_angle(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        int16_t dx    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        uint8_t angle = atan2_8(dy, dx);
+        rgb_t   rgb   = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, 0, angle, time));
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+#endif
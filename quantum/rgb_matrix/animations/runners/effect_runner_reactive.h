@@ -5,9 +5,25 @@
 typedef hsv_t (*reactive_f)(hsv_t hsv, uint16_t offset);
 
 bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
-    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    static bool was_idle = false;
 
     uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    if (params->iter == 0) {
+        // Once every hit has faded out to black, every frame looks the same
+        rgb_t rgb  = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, scale16by8(max_tick, qadd8(rgb_matrix_config.speed, 1))));
+        bool  idle = !(rgb.r | rgb.g | rgb.b);
+        for (uint8_t j = 0; idle && j < g_last_hit_tracker.count; j++) {
+            if (g_last_hit_tracker.tick[j] < max_tick) {
+                idle = false;
+            }
+        }
+        if (idle && was_idle && rgb_matrix_frame_unchanged(params)) {
+            return false;
+        }
+        was_idle = idle;
+    }
+
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -2,6 +2,7 @@ RGB_MATRIX_EFFECT(SOLID_COLOR)
 #ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 bool SOLID_COLOR(effect_params_t* params) {
+    if (rgb_matrix_frame_unchanged(params)) return false;
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     rgb_t rgb = rgb_matrix_hsv_to_rgb(rgb_matrix_config.hsv);
@@ -20,6 +20,32 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+#        elif defined(RGB_MATRIX_LED_TABLES) && RGB_MATRIX_TYPING_HEATMAP_SPREAD <= RGB_MATRIX_LED_NEIGHBOUR_RADIUS
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+
+    // Neighbours are sorted by distance, so stop at the first one out of reach
+    uint16_t end = pgm_read_word(&g_led_neighbour_offsets[led + 1]);
+    for (uint16_t n = pgm_read_word(&g_led_neighbour_offsets[led]); n < end; n++) {
+        uint8_t distance = pgm_read_byte(&g_led_neighbours[n].dist);
+        if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+            break;
+        }
+        uint8_t neighbour = pgm_read_byte(&g_led_neighbours[n].index);
+        uint8_t i_row     = pgm_read_byte(&g_led_matrix_pos[neighbour].row);
+        uint8_t i_col     = pgm_read_byte(&g_led_matrix_pos[neighbour].col);
+        if (i_row >= MATRIX_ROWS) { // skip as target led doesn't have a key
+            continue;
+        }
+        uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+        if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+            amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+        }
+        g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
+    }
 #        else
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
@@ -77,6 +77,18 @@ static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+// frame tracking, lets static effects skip rendering and flushing
+static bool     rgb_effect_rendering  = false; // set while the current effect is drawing
+static bool     rgb_frame_drawn       = false; // any LED was written since the last flush
+static bool     rgb_frame_reused      = false; // the effect kept the previous frame instead of drawing
+static bool     rgb_frame_valid       = false; // the LEDs hold exactly what the effect last drew, plus the last overlay
+static uint32_t rgb_overlay_hash      = 0;     // hash of the LEDs written by anything but the effect since the last flush
+static uint32_t rgb_last_overlay_hash = 0;     // ...and the same for the previous frame
+static hsv_t    rgb_frame_hsv;
+static uint8_t  rgb_frame_speed;
+static hsv_t    rgb_valid_hsv;
+static uint8_t  rgb_valid_speed;
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -152,11 +164,27 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
     return index;
 }
 
+static inline void rgb_overlay_add(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    // FNV-1a over everything drawn on top of the effect, e.g. by indicators
+    const uint8_t data[] = {index, red, green, blue};
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        rgb_overlay_hash = (rgb_overlay_hash ^ data[i]) * 16777619UL;
+    }
+}
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_frame_drawn = true;
+    if (!rgb_effect_rendering) {
+        rgb_overlay_add(index, red, green, blue);
+    }
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_frame_drawn = true;
+    if (!rgb_effect_rendering) {
+        rgb_overlay_add(UINT8_MAX, red, green, blue);
+    }
 #if defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
@@ -239,6 +267,35 @@ void rgb_matrix_test(void) {
     }
 }
 
+static inline bool rgb_frame_settings_current(hsv_t hsv, uint8_t speed) {
+    return hsv.h == rgb_matrix_config.hsv.h && hsv.s == rgb_matrix_config.hsv.s && hsv.v == rgb_matrix_config.hsv.v && speed == rgb_matrix_config.speed;
+}
+
+bool rgb_matrix_frame_unchanged(effect_params_t *params) {
+    // Only the first iteration may skip, and only if the previous frame was drawn with the same settings
+    if (params->iter == 0 && !params->init && rgb_frame_valid && rgb_frame_settings_current(rgb_valid_hsv, rgb_valid_speed)) {
+        rgb_frame_reused = true;
+        return true;
+    }
+    return false;
+}
+
+led_polar_t rgb_matrix_led_polar(uint8_t index) {
+#ifdef RGB_MATRIX_LED_TABLES
+    return (led_polar_t){
+        .dist  = pgm_read_byte(&g_led_polar[index].dist),
+        .angle = pgm_read_byte(&g_led_polar[index].angle),
+    };
+#else
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return (led_polar_t){
+        .dist  = sqrt16(dx * dx + dy * dy),
+        .angle = atan2_8(dy, dx),
+    };
+#endif
+}
+
 static bool rgb_matrix_none(effect_params_t *params) {
     if (!params->init) {
         return false;
@@ -282,6 +339,8 @@ static void rgb_task_start(void) {
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_frame_hsv   = rgb_matrix_config.hsv;
+    rgb_frame_speed = rgb_matrix_config.speed;
 
     // next task
     rgb_task_state = RENDERING;
@@ -290,13 +349,16 @@ static void rgb_task_start(void) {
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+
+    // each effect can opt to do calculations
+    // and/or request PWM buffer updates.
+    rgb_effect_rendering = true;
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
+        // the previous frame is gone, so the effect has to draw it again
+        rgb_frame_valid = false;
     }
-
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
     switch (effect) {
         case RGB_MATRIX_NONE:
             rendering = rgb_matrix_none(&rgb_effect_params);
@@ -329,11 +391,13 @@ static void rgb_task_render(uint8_t effect) {
 
         // Factory default magic value
         case UINT8_MAX: {
+            rgb_effect_rendering = false;
             rgb_matrix_test();
             rgb_task_state = FLUSHING;
         }
             return;
     }
+    rgb_effect_rendering = false;
 
     rgb_effect_params.iter++;
 
@@ -348,12 +412,34 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+    // the effect kept the previous frame, but what was drawn on top of it changed -- e.g. an indicator turned off --
+    // so parts of the old overlay may still be showing: have the effect draw the frame after all
+    bool overlay_changed  = rgb_overlay_hash != rgb_last_overlay_hash;
+    rgb_last_overlay_hash = rgb_overlay_hash;
+    rgb_overlay_hash      = 0;
+    if (rgb_frame_reused && overlay_changed) {
+        rgb_frame_reused       = false;
+        rgb_frame_valid        = false;
+        rgb_effect_params.iter = 0;
+        rgb_task_state         = RENDERING;
+        return;
+    }
+    rgb_frame_reused = false;
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
-    // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
+    // the frame can only be reused if the settings held for the whole frame
+    rgb_frame_valid = rgb_frame_settings_current(rgb_frame_hsv, rgb_frame_speed);
+    rgb_valid_hsv   = rgb_frame_hsv;
+    rgb_valid_speed = rgb_frame_speed;
+
+    // update pwm buffers, unless no LED has been touched since the last flush
+    if (rgb_frame_drawn) {
+        rgb_matrix_update_pwm_buffers();
+    }
+    rgb_frame_drawn = false;
 
     // next task
     rgb_task_state = SYNCING;
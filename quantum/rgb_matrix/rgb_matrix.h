@@ -49,6 +49,10 @@
 #    define RGB_MATRIX_SPD_STEP 16
 #endif
 
+#ifndef RGB_MATRIX_LED_NEIGHBOUR_RADIUS
+#    define RGB_MATRIX_LED_NEIGHBOUR_RADIUS 40
+#endif
+
 #ifndef RGB_MATRIX_DEFAULT_ON
 #    define RGB_MATRIX_DEFAULT_ON true
 #endif
@@ -150,6 +154,15 @@ int rgb_matrix_led_index(int index);
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+// Effects whose output only depends on the current settings can return early
+// when this is true: the LEDs still hold their previous frame, and nothing
+// else has drawn over it, so rendering and flushing can both be skipped
+bool rgb_matrix_frame_unchanged(effect_params_t *params);
+
+// Distance and atan2_8() angle of an LED from k_rgb_matrix_center, read from
+// the generated tables when RGB_MATRIX_LED_TABLES is enabled
+led_polar_t rgb_matrix_led_polar(uint8_t index);
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
@@ -280,3 +293,10 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_LED_TABLES
+// Generated from the info.json LED layout by `qmk generate-keyboard-c`
+extern const led_polar_t     g_led_polar[RGB_MATRIX_LED_COUNT];
+extern const keypos_t        g_led_matrix_pos[RGB_MATRIX_LED_COUNT];
+extern const uint16_t        g_led_neighbour_offsets[RGB_MATRIX_LED_COUNT + 1];
+extern const led_neighbour_t g_led_neighbours[];
+#endif
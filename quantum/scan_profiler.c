@@ -0,0 +1,200 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_profiler.h"
+#include "timer.h"
+#include "print.h"
+#include "util.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#elif defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#endif
+
+typedef struct scan_profiler_task_t {
+    const char *name;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint8_t     head;
+    uint32_t    samples[SCAN_PROFILER_SAMPLE_COUNT];
+} scan_profiler_task_t;
+
+static scan_profiler_task_t tasks[SCAN_PROFILER_MAX_TASKS];
+static uint8_t              task_count = 0;
+
+#if defined(PROTOCOL_CHIBIOS) && defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+#    define SCAN_PROFILER_UNITS "cycles"
+#elif defined(PROTOCOL_CHIBIOS)
+#    define SCAN_PROFILER_UNITS "systicks"
+#elif defined(__AVR__)
+#    define SCAN_PROFILER_UNITS "timer0 ticks"
+#else
+#    define SCAN_PROFILER_UNITS "ms"
+#endif
+
+__attribute__((weak)) uint32_t scan_profiler_timestamp(void) {
+#if defined(PROTOCOL_CHIBIOS) && defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+    return (uint32_t)chSysGetRealtimeCounterX();
+#elif defined(PROTOCOL_CHIBIOS)
+    return (uint32_t)chVTGetSystemTimeX();
+#elif defined(__AVR__)
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        // Account for a compare match that happened while interrupts were masked
+#    if defined(__AVR_ATmega32A__)
+        if (TIFR & _BV(OCF0)) {
+#    elif defined(__AVR_ATtiny85__)
+        if (TIFR & _BV(OCF0A)) {
+#    else
+        if (TIFR0 & _BV(OCF0A)) {
+#    endif
+            ms++;
+            raw = TIMER_RAW;
+        }
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+#else
+    return timer_read32();
+#endif
+}
+
+static inline uint32_t scan_profiler_elapsed(uint32_t start) {
+#if defined(PROTOCOL_CHIBIOS) && !(defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE))
+    // systime_t may be narrower than 32 bits
+    return (systime_t)((systime_t)scan_profiler_timestamp() - (systime_t)start);
+#else
+    return TIMER_DIFF_32(scan_profiler_timestamp(), start);
+#endif
+}
+
+void scan_profiler_record(uint8_t *slot, const char *name, uint32_t start) {
+    uint32_t elapsed = scan_profiler_elapsed(start);
+
+    if (*slot == SCAN_PROFILER_SLOT_UNASSIGNED) {
+        if (task_count >= SCAN_PROFILER_MAX_TASKS) {
+            return;
+        }
+        *slot             = task_count++;
+        tasks[*slot].name = name;
+        tasks[*slot].min  = UINT32_MAX;
+    }
+
+    scan_profiler_task_t *task = &tasks[*slot];
+    task->samples[task->head]  = elapsed;
+    task->head                 = (task->head + 1) % SCAN_PROFILER_SAMPLE_COUNT;
+    task->min                  = MIN(task->min, elapsed);
+    task->max                  = MAX(task->max, elapsed);
+    if (task->count < UINT32_MAX) {
+        task->count++;
+    }
+}
+
+uint8_t scan_profiler_task_count(void) {
+    return task_count;
+}
+
+bool scan_profiler_get_stats(uint8_t index, scan_profiler_stats_t *stats) {
+    if (index >= task_count) {
+        return false;
+    }
+
+    const scan_profiler_task_t *task = &tasks[index];
+    stats->name                      = task->name;
+    stats->count                     = task->count;
+    stats->min                       = task->count ? task->min : 0;
+    stats->max                       = task->max;
+    stats->p50                       = 0;
+    stats->p99                       = 0;
+
+    uint8_t n = MIN(task->count, SCAN_PROFILER_SAMPLE_COUNT);
+    if (n == 0) {
+        return true;
+    }
+
+    // Insertion sort a copy of the ring -- it's small, and this only runs on demand
+    uint32_t sorted[SCAN_PROFILER_SAMPLE_COUNT];
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t value = task->samples[i];
+        uint8_t  j     = i;
+        for (; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+    // Nearest-rank percentiles
+    stats->p50 = sorted[((uint16_t)n * 50 + 99) / 100 - 1];
+    stats->p99 = sorted[((uint16_t)n * 99 + 99) / 100 - 1];
+    return true;
+}
+
+void scan_profiler_reset(void) {
+    for (uint8_t i = 0; i < task_count; i++) {
+        tasks[i].count = 0;
+        tasks[i].min   = UINT32_MAX;
+        tasks[i].max   = 0;
+        tasks[i].head  = 0;
+    }
+}
+
+void scan_profiler_print(void) {
+    scan_profiler_stats_t stats;
+    uprintf("scan profiler (" SCAN_PROFILER_UNITS "): count min p50 p99 max\n");
+    for (uint8_t i = 0; i < task_count; i++) {
+        if (scan_profiler_get_stats(i, &stats)) {
+            uprintf("%s: %lu %lu %lu %lu %lu\n", stats.name, (unsigned long)stats.count, (unsigned long)stats.min, (unsigned long)stats.p50, (unsigned long)stats.p99, (unsigned long)stats.max);
+        }
+    }
+}
+
+static uint8_t serialize_u32(uint8_t *data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
+    return sizeof(uint32_t);
+}
+
+uint8_t scan_profiler_serialize(uint8_t index, uint8_t *data, uint8_t length) {
+    scan_profiler_stats_t stats;
+    uint8_t               offset = 0;
+
+    if (length < 2 + 5 * sizeof(uint32_t) || !scan_profiler_get_stats(index, &stats)) {
+        return 0;
+    }
+
+    data[offset++] = task_count;
+    data[offset++] = index;
+    offset += serialize_u32(&data[offset], stats.count);
+    offset += serialize_u32(&data[offset], stats.min);
+    offset += serialize_u32(&data[offset], stats.max);
+    offset += serialize_u32(&data[offset], stats.p50);
+    offset += serialize_u32(&data[offset], stats.p99);
+
+    if (offset < length) {
+        uint8_t name_length = MIN(strlen(stats.name), length - offset - 1);
+        memcpy(&data[offset], stats.name, name_length);
+        offset += name_length;
+        data[offset++] = 0;
+    }
+
+    return offset;
+}
+
+void scan_profiler_task(void) {
+#if SCAN_PROFILER_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= SCAN_PROFILER_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        scan_profiler_print();
+    }
+#endif // SCAN_PROFILER_PRINT_INTERVAL > 0
+}
@@ -0,0 +1,131 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Scan-loop profiler: times each task invoked from keyboard_task()/quantum_task() and keeps
+    a ring of recent samples per task so that min/max/p50/p99 latencies can be reported.
+
+    Enable with `SCAN_PROFILER_ENABLE = yes` in rules.mk. Results can be dumped over console
+    with scan_profiler_print(), periodically by defining SCAN_PROFILER_PRINT_INTERVAL, or
+    retrieved over raw HID with scan_profiler_serialize().
+
+    Additional code can be profiled in the same way as the core tasks:
+
+        SCAN_PROFILE(my_expensive_task());
+
+        SCAN_PROFILE_NAMED("oled_render", {
+            render_status();
+        });
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SCAN_PROFILER_MAX_TASKS
+#    define SCAN_PROFILER_MAX_TASKS 24
+#endif // SCAN_PROFILER_MAX_TASKS
+
+#ifndef SCAN_PROFILER_SAMPLE_COUNT
+#    define SCAN_PROFILER_SAMPLE_COUNT 32
+#endif // SCAN_PROFILER_SAMPLE_COUNT
+
+#ifndef SCAN_PROFILER_PRINT_INTERVAL
+#    define SCAN_PROFILER_PRINT_INTERVAL 0
+#endif // SCAN_PROFILER_PRINT_INTERVAL
+
+#if SCAN_PROFILER_MAX_TASKS > 254
+#    error "SCAN_PROFILER_MAX_TASKS must be less than 255"
+#endif
+#if SCAN_PROFILER_SAMPLE_COUNT < 1 || SCAN_PROFILER_SAMPLE_COUNT > 255
+#    error "SCAN_PROFILER_SAMPLE_COUNT must be between 1 and 255"
+#endif
+
+#define SCAN_PROFILER_SLOT_UNASSIGNED 0xFF
+
+/**
+ * @brief Latency statistics for a single profiled task, in scan_profiler_timestamp() ticks.
+ */
+typedef struct scan_profiler_stats_t {
+    const char *name;
+    uint32_t    count; // total number of invocations since the last reset
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    p50; // percentiles are computed over the most recent SCAN_PROFILER_SAMPLE_COUNT samples
+    uint32_t    p99;
+} scan_profiler_stats_t;
+
+#ifdef SCAN_PROFILER_ENABLE
+
+/**
+ * @brief Reads the profiler's free-running tick counter.
+ *
+ * Uses the CPU cycle counter where available, otherwise the finest system timer the platform offers.
+ */
+uint32_t scan_profiler_timestamp(void);
+
+/**
+ * @brief Records a sample for the task identified by `slot`, measured from `start` until now.
+ *
+ * `slot` should point to call-site static storage initialised to SCAN_PROFILER_SLOT_UNASSIGNED; it is
+ * assigned on first use. Tasks beyond SCAN_PROFILER_MAX_TASKS are silently ignored.
+ */
+void scan_profiler_record(uint8_t *slot, const char *name, uint32_t start);
+
+/**
+ * @brief Returns the number of tasks that have been profiled so far.
+ */
+uint8_t scan_profiler_task_count(void);
+
+/**
+ * @brief Computes the statistics for the given task.
+ *
+ * @return false if `index` does not refer to a profiled task
+ */
+bool scan_profiler_get_stats(uint8_t index, scan_profiler_stats_t *stats);
+
+/**
+ * @brief Clears all gathered samples. Task slot assignments are retained.
+ */
+void scan_profiler_reset(void);
+
+/**
+ * @brief Prints a table of all profiled tasks over console.
+ */
+void scan_profiler_print(void);
+
+/**
+ * @brief Serializes the statistics for the given task into a raw HID payload.
+ *
+ * Layout: task count, task index, then count/min/max/p50/p99 as little-endian uint32_t, followed by
+ * as much of the NUL-terminated task name as fits.
+ *
+ * @return the number of bytes written, or 0 if `index` is invalid or `length` is too small
+ */
+uint8_t scan_profiler_serialize(uint8_t index, uint8_t *data, uint8_t length);
+
+/**
+ * @brief Handles periodic printing; invoked from keyboard_task().
+ */
+void scan_profiler_task(void);
+
+#    define SCAN_PROFILE_NAMED(name, call)                                               \
+        do {                                                                             \
+            static uint8_t scan_profiler_slot  = SCAN_PROFILER_SLOT_UNASSIGNED;          \
+            uint32_t       scan_profiler_start = scan_profiler_timestamp();              \
+            do {                                                                         \
+                call;                                                                    \
+            } while (0);                                                                 \
+            scan_profiler_record(&scan_profiler_slot, (name), scan_profiler_start);      \
+        } while (0)
+
+#else
+
+#    define SCAN_PROFILE_NAMED(name, call) \
+        do {                               \
+            call;                          \
+        } while (0)
+
+#endif // SCAN_PROFILER_ENABLE
+
+#define SCAN_PROFILE(call) SCAN_PROFILE_NAMED(#call, call)
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 4
+
+#define SPLIT_TRANSACTION_BATCH
+#define SPLIT_TRANSACTION_BATCH_SIZE 32
+#define SPLIT_TRANSACTION_IDS_USER TEST_SMALL, TEST_MEDIUM, TEST_LARGE
+#define RPC_M2S_BUFFER_SIZE 64
+
+// The split headers are shared with C, which spells this differently
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
@@ -0,0 +1,8 @@
+split_transaction_batch_DEFS := -DSPLIT_KEYBOARD
+split_transaction_batch_INC := $(QUANTUM_PATH)/split_common
+split_transaction_batch_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_transaction_batch_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/transaction_batch_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transaction_batch.c \
+	$(QUANTUM_PATH)/crc.c
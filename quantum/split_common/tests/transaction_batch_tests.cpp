@@ -0,0 +1,219 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include <string.h>
+#include "crc.h"
+#include "transactions.h"
+#include "transaction_batch.h"
+
+static split_shared_memory_t shared_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+split_transaction_desc_t     split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+
+static int callback_count;
+
+static void test_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    callback_count++;
+}
+}
+
+#define SMALL_SIZE 4
+#define MEDIUM_SIZE 12
+#define LARGE_SIZE 40
+
+class TransactionBatch : public ::testing::Test {
+   protected:
+    // The slave's copy of shared memory, which frames are applied to
+    split_shared_memory_t slave_memory;
+
+    void SetUp() override {
+        uint16_t rpc = offsetof(split_shared_memory_t, rpc_m2s_buffer);
+        memset(split_transaction_table, 0, sizeof(split_transaction_table));
+        split_transaction_table[EXCHANGE_BATCH_EMPTY]  = {0, offsetof(split_shared_memory_t, batch), 0, 0, NULL};
+        split_transaction_table[EXCHANGE_BATCH_SMALL]  = {SPLIT_TRANSACTION_BATCH_SIZE / 4, offsetof(split_shared_memory_t, batch), 0, 0, NULL};
+        split_transaction_table[EXCHANGE_BATCH_MEDIUM] = {SPLIT_TRANSACTION_BATCH_SIZE / 2, offsetof(split_shared_memory_t, batch), 0, 0, NULL};
+        split_transaction_table[EXCHANGE_BATCH_LARGE]  = {SPLIT_TRANSACTION_BATCH_SIZE, offsetof(split_shared_memory_t, batch), 0, 0, NULL};
+        split_transaction_table[TEST_SMALL]            = {SMALL_SIZE, rpc, 0, 0, test_callback};
+        split_transaction_table[TEST_MEDIUM]           = {MEDIUM_SIZE, (uint16_t)(rpc + SMALL_SIZE), 0, 0, test_callback};
+        split_transaction_table[TEST_LARGE]            = {LARGE_SIZE, (uint16_t)(rpc + SMALL_SIZE + MEDIUM_SIZE), 0, 0, test_callback};
+
+        // Drop anything left queued by a previous test
+        transaction_batch_complete(true);
+        memset(&shared_memory, 0, sizeof(shared_memory));
+        memset(&slave_memory, 0, sizeof(slave_memory));
+        callback_count = 0;
+    }
+
+    uint8_t *buffer(int8_t id, split_shared_memory_t *memory = split_shmem) {
+        return ((uint8_t *)memory) + split_transaction_table[id].initiator2target_offset;
+    }
+
+    // Applies a frame to the slave's copy of shared memory, as the slave would
+    bool apply_on_slave(const uint8_t *frame, uint8_t size) {
+        split_shared_memory_t master_memory;
+        memcpy(&master_memory, &shared_memory, sizeof(shared_memory));
+        memcpy(&shared_memory, &slave_memory, sizeof(shared_memory));
+        bool valid = transaction_batch_walk(frame, size, false, false);
+        if (valid) {
+            transaction_batch_walk(frame, size, true, true);
+        }
+        memcpy(&slave_memory, &shared_memory, sizeof(shared_memory));
+        memcpy(&shared_memory, &master_memory, sizeof(shared_memory));
+        return valid;
+    }
+};
+
+TEST_F(TransactionBatch, EmptyFrame) {
+    const uint8_t *frame;
+    uint8_t        size;
+    EXPECT_EQ(transaction_batch_seal(&frame, &size), EXCHANGE_BATCH_EMPTY);
+    EXPECT_EQ(size, 0);
+}
+
+TEST_F(TransactionBatch, RoundTrip) {
+    uint8_t small[SMALL_SIZE]   = {1, 2, 3, 4};
+    uint8_t medium[MEDIUM_SIZE] = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), true));
+    EXPECT_TRUE(transaction_batch_queue(TEST_MEDIUM, medium, sizeof(medium), true));
+
+    const uint8_t *frame;
+    uint8_t        size;
+    EXPECT_EQ(transaction_batch_seal(&frame, &size), EXCHANGE_BATCH_LARGE);
+    EXPECT_EQ(size, SPLIT_TRANSACTION_BATCH_SIZE);
+    EXPECT_EQ(frame[0], crc8(&frame[1], size - 1));
+
+    EXPECT_TRUE(apply_on_slave(frame, size));
+    EXPECT_EQ(memcmp(buffer(TEST_SMALL, &slave_memory), small, sizeof(small)), 0);
+    EXPECT_EQ(memcmp(buffer(TEST_MEDIUM, &slave_memory), medium, sizeof(medium)), 0);
+    EXPECT_EQ(callback_count, 2);
+
+    // The master's mirror only follows once the slave has acknowledged the frame
+    EXPECT_NE(memcmp(buffer(TEST_SMALL), small, sizeof(small)), 0);
+    transaction_batch_complete(true);
+    EXPECT_EQ(memcmp(buffer(TEST_SMALL), small, sizeof(small)), 0);
+    EXPECT_EQ(memcmp(buffer(TEST_MEDIUM), medium, sizeof(medium)), 0);
+    EXPECT_EQ(callback_count, 2);
+
+    EXPECT_EQ(transaction_batch_seal(&frame, &size), EXCHANGE_BATCH_EMPTY);
+}
+
+TEST_F(TransactionBatch, DeltaOnlyCarriesChangedSpan) {
+    uint8_t medium[MEDIUM_SIZE] = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    memcpy(buffer(TEST_MEDIUM), medium, sizeof(medium));
+    medium[4] = 0x40;
+    medium[6] = 0x41;
+    EXPECT_TRUE(transaction_batch_queue(TEST_MEDIUM, medium, sizeof(medium), true));
+
+    const uint8_t *frame;
+    uint8_t        size;
+    EXPECT_EQ(transaction_batch_seal(&frame, &size), EXCHANGE_BATCH_SMALL);
+    const uint8_t expected[] = {TEST_MEDIUM, 4, 3, 0x40, 10, 0x41, BATCH_FRAME_END};
+    EXPECT_EQ(memcmp(&frame[1], expected, sizeof(expected)), 0);
+}
+
+TEST_F(TransactionBatch, UnchangedOrUndeltaedDataIsSentInFull) {
+    uint8_t small[SMALL_SIZE] = {1, 2, 3, 4};
+    memcpy(buffer(TEST_SMALL), small, sizeof(small));
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), true));
+
+    const uint8_t *frame;
+    uint8_t        size;
+    transaction_batch_seal(&frame, &size);
+    EXPECT_EQ(frame[2], 0);
+    EXPECT_EQ(frame[3], SMALL_SIZE);
+    transaction_batch_complete(true);
+
+    small[3] = 5;
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), false));
+    transaction_batch_seal(&frame, &size);
+    EXPECT_EQ(frame[2], 0);
+    EXPECT_EQ(frame[3], SMALL_SIZE);
+}
+
+TEST_F(TransactionBatch, UnacknowledgedRecordsAreResent) {
+    uint8_t small[SMALL_SIZE]   = {1, 2, 3, 4};
+    uint8_t medium[MEDIUM_SIZE] = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), true));
+    EXPECT_TRUE(transaction_batch_queue(TEST_MEDIUM, medium, sizeof(medium), true));
+
+    const uint8_t *frame;
+    uint8_t        size;
+    transaction_batch_seal(&frame, &size);
+    transaction_batch_complete(false);
+    EXPECT_EQ(buffer(TEST_SMALL)[0], 0);
+
+    // A newer write replaces the pending record rather than being applied before it
+    small[0] = 9;
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), true));
+    transaction_batch_seal(&frame, &size);
+    EXPECT_EQ(frame[1], TEST_MEDIUM);
+    EXPECT_EQ(frame[1 + BATCH_RECORD_HEADER_SIZE + MEDIUM_SIZE], TEST_SMALL);
+    EXPECT_EQ(frame[1 + 2 * BATCH_RECORD_HEADER_SIZE + MEDIUM_SIZE + SMALL_SIZE], BATCH_FRAME_END);
+
+    EXPECT_TRUE(apply_on_slave(frame, size));
+    EXPECT_EQ(memcmp(buffer(TEST_SMALL, &slave_memory), small, sizeof(small)), 0);
+    EXPECT_EQ(memcmp(buffer(TEST_MEDIUM, &slave_memory), medium, sizeof(medium)), 0);
+}
+
+TEST_F(TransactionBatch, OverflowIsSentOnItsOwn) {
+    uint8_t large[LARGE_SIZE];
+    memset(large, 0x55, sizeof(large));
+    EXPECT_FALSE(transaction_batch_queue(TEST_LARGE, large, sizeof(large), true));
+
+    uint8_t oversized[300];
+    memset(oversized, 0x55, sizeof(oversized));
+    EXPECT_FALSE(transaction_batch_queue(TEST_LARGE, oversized, sizeof(oversized), true));
+
+    // Partial writes are never batched
+    EXPECT_FALSE(transaction_batch_queue(TEST_LARGE, large, 10, true));
+
+    // Once the frame is full, the next record doesn't fit
+    uint8_t medium[MEDIUM_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    uint8_t small[SMALL_SIZE]   = {1, 2, 3, 4};
+    EXPECT_TRUE(transaction_batch_queue(TEST_MEDIUM, medium, sizeof(medium), true));
+    EXPECT_TRUE(transaction_batch_queue(TEST_SMALL, small, sizeof(small), true));
+    memset(large, 0, sizeof(large));
+    large[0] = 1;
+    large[9] = 2;
+    EXPECT_FALSE(transaction_batch_queue(TEST_LARGE, large, sizeof(large), true));
+
+    const uint8_t *frame;
+    uint8_t        size;
+    EXPECT_EQ(transaction_batch_seal(&frame, &size), EXCHANGE_BATCH_LARGE);
+    EXPECT_TRUE(apply_on_slave(frame, size));
+    EXPECT_EQ(buffer(TEST_LARGE, &slave_memory)[0], 0);
+}
+
+TEST_F(TransactionBatch, MalformedFramesAreRejected) {
+    uint8_t frame[16];
+    memset(frame, BATCH_FRAME_END, sizeof(frame));
+
+    // Unknown transaction
+    const uint8_t unknown[] = {NUM_TOTAL_TRANSACTIONS, 0, 1, 0x55};
+    memcpy(&frame[1], unknown, sizeof(unknown));
+    EXPECT_FALSE(apply_on_slave(frame, sizeof(frame)));
+
+    // Record runs past the end of the frame
+    const uint8_t truncated[] = {TEST_LARGE, 0, 13, 0x55};
+    memset(frame, BATCH_FRAME_END, sizeof(frame));
+    memcpy(&frame[1], truncated, sizeof(truncated));
+    EXPECT_FALSE(apply_on_slave(frame, sizeof(frame)));
+
+    // Record runs past the end of the transaction's buffer
+    const uint8_t outside[] = {TEST_SMALL, 3, 2, 0x55, 0x55};
+    memset(frame, BATCH_FRAME_END, sizeof(frame));
+    memcpy(&frame[1], outside, sizeof(outside));
+    EXPECT_FALSE(apply_on_slave(frame, sizeof(frame)));
+
+    // A valid record followed by a broken one isn't applied either
+    const uint8_t partial[] = {TEST_SMALL, 0, 1, 0x55, TEST_SMALL, 4, 1, 0x55};
+    memset(frame, BATCH_FRAME_END, sizeof(frame));
+    memcpy(&frame[1], partial, sizeof(partial));
+    EXPECT_FALSE(apply_on_slave(frame, sizeof(frame)));
+
+    EXPECT_EQ(buffer(TEST_SMALL, &slave_memory)[0], 0);
+    EXPECT_EQ(callback_count, 0);
+}
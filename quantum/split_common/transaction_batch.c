@@ -0,0 +1,119 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "crc.h"
+#include "transactions.h"
+#include "transaction_batch.h"
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+static uint8_t batch_frame[SPLIT_TRANSACTION_BATCH_SIZE];
+static uint8_t batch_length = 1;
+
+bool transaction_batch_walk(const uint8_t *frame, uint8_t length, bool apply, bool callbacks) {
+    uint8_t pos = 1;
+    while (pos + BATCH_RECORD_HEADER_SIZE <= length && frame[pos] != BATCH_FRAME_END) {
+        uint8_t id    = frame[pos];
+        uint8_t start = frame[pos + 1];
+        uint8_t count = frame[pos + 2];
+        pos += BATCH_RECORD_HEADER_SIZE;
+
+        if (id >= NUM_TOTAL_TRANSACTIONS || count > length - pos) {
+            return false;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (start + count > trans->initiator2target_buffer_size) {
+            return false;
+        }
+
+        if (apply) {
+            memcpy(split_trans_initiator2target_buffer(trans) + start, &frame[pos], count);
+            if (callbacks && trans->slave_callback) {
+                trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+        }
+        pos += count;
+    }
+    return true;
+}
+
+// Removes the queued record for a transaction, if there is one
+static void batch_drop(int8_t id) {
+    uint8_t pos = 1;
+    while (pos < batch_length) {
+        uint8_t size = BATCH_RECORD_HEADER_SIZE + batch_frame[pos + 2];
+        if (batch_frame[pos] == id) {
+            memmove(&batch_frame[pos], &batch_frame[pos + size], batch_length - pos - size);
+            batch_length -= size;
+            return;
+        }
+        pos += size;
+    }
+}
+
+bool transaction_batch_queue(int8_t id, const void *data, uint16_t length, bool delta) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    // Records describe the whole buffer of a transaction, which can be at most 255 bytes
+    if (length > UINT8_MAX || length != trans->initiator2target_buffer_size) {
+        return false;
+    }
+
+    // Newer data supersedes anything still waiting to be acknowledged
+    batch_drop(id);
+
+    // Find the span that differs from what the slave already has
+    const uint8_t *source = data;
+    const uint8_t *mirror = split_trans_initiator2target_buffer(trans);
+    uint8_t        start  = 0;
+    uint8_t        end    = length;
+    if (delta) {
+        while (start < end && source[start] == mirror[start]) {
+            start++;
+        }
+        while (end > start && source[end - 1] == mirror[end - 1]) {
+            end--;
+        }
+    }
+    if (start == end) {
+        start = 0;
+        end   = length;
+    }
+
+    uint8_t count = end - start;
+    if (BATCH_RECORD_HEADER_SIZE + count > sizeof(batch_frame) - batch_length) {
+        return false;
+    }
+
+    batch_frame[batch_length++] = id;
+    batch_frame[batch_length++] = start;
+    batch_frame[batch_length++] = count;
+    memcpy(&batch_frame[batch_length], &source[start], count);
+    batch_length += count;
+    return true;
+}
+
+int8_t transaction_batch_seal(const uint8_t **frame, uint8_t *size) {
+    int8_t  id   = EXCHANGE_BATCH_EMPTY;
+    uint8_t used = batch_length > 1 ? batch_length : 0;
+    while (split_transaction_table[id].initiator2target_buffer_size < used) {
+        id++;
+    }
+    *size = split_transaction_table[id].initiator2target_buffer_size;
+    if (*size) {
+        memset(&batch_frame[batch_length], BATCH_FRAME_END, *size - batch_length);
+        batch_frame[0] = crc8(&batch_frame[1], *size - 1);
+    }
+    *frame = batch_frame;
+    return id;
+}
+
+void transaction_batch_complete(bool acknowledged) {
+    if (acknowledged) {
+        transaction_batch_walk(batch_frame, batch_length, true, false);
+        batch_length = 1;
+    }
+}
+
+#endif // SPLIT_TRANSACTION_BATCH
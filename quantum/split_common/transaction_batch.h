@@ -0,0 +1,28 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Frame layout: crc8 of the remainder of the frame, followed by records of {id, start, length, data[length]} padded
+ * with BATCH_FRAME_END. Each record carries the span of a transaction's buffer that differs from the state the slave
+ * last acknowledged, which the master mirrors in its own shared memory. Records that the slave has not acknowledged
+ * stay queued for the next frame, replaced by any newer write to the same transaction.
+ */
+
+#define BATCH_FRAME_END 0xFF
+#define BATCH_RECORD_HEADER_SIZE 3
+
+// Queues a write into the frame, returns false if it has to be sent on its own instead
+bool transaction_batch_queue(int8_t id, const void *data, uint16_t length, bool delta);
+
+// Pads the queued records out to the smallest frame size that fits, returning the transaction to send it with
+int8_t transaction_batch_seal(const uint8_t **frame, uint8_t *size);
+
+// Finishes the exchange of the sealed frame; once acknowledged, its records become the state later deltas are taken against
+void transaction_batch_complete(bool acknowledged);
+
+// Validates a received frame, and copies its records into shared memory if apply is set
+bool transaction_batch_walk(const uint8_t *frame, uint8_t length, bool apply, bool callbacks);
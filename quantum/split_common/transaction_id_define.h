@@ -24,6 +24,13 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    EXCHANGE_BATCH_EMPTY,
+    EXCHANGE_BATCH_SMALL,
+    EXCHANGE_BATCH_MEDIUM,
+    EXCHANGE_BATCH_LARGE,
+#endif // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -31,6 +31,10 @@
 #include "split_util.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_TRANSACTION_BATCH
+#    include "transaction_batch.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -84,7 +88,12 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BATCH
+static bool batch_write(int8_t id, const void *data, uint16_t length);
+#    define transport_write(id, data, length) batch_write(id, data, length)
+#else // SPLIT_TRANSACTION_BATCH
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#endif // SPLIT_TRANSACTION_BATCH
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
@@ -178,6 +187,8 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifndef SPLIT_TRANSACTION_BATCH
+// With batched transactions the slave matrix is exchanged along with each batch instead
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -192,6 +203,7 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
     return okay;
 }
+#endif // SPLIT_TRANSACTION_BATCH
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
@@ -206,6 +218,136 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+////////////////////////////////////////////////////
+// Batched transactions
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+/*
+ * While the master runs its handlers, writes are queued into a single frame rather than executed one at a time. The
+ * frame is then exchanged for the slave matrix in one transaction, using the smallest of the registered frame sizes
+ * that fits. The slave echoes the checksum of each frame it applies, and writes from a frame that was not applied are
+ * sent again with the next one. See transaction_batch.h for the frame layout.
+ */
+
+static bool batch_active = false;
+
+// The slave modifies these after receiving them, so the master's mirror can't be used to work out what changed
+static bool batch_delta_allowed(int8_t id) {
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    // rgblight_handlers_slave() clears the change flags once they have been applied
+    if (id == PUT_RGBLIGHT) {
+        return false;
+    }
+#    endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    return true;
+}
+
+static bool batch_write(int8_t id, const void *data, uint16_t length) {
+    if (batch_active && transaction_batch_queue(id, data, length, batch_delta_allowed(id))) {
+        return true;
+    }
+    // Anything that doesn't fit goes out on its own
+    return transport_execute_transaction(id, data, length, NULL, 0);
+}
+
+static matrix_row_t batch_last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+
+static bool batch_acknowledge(bool okay, const uint8_t *frame, uint8_t size, const split_batch_reply_t *reply) {
+    okay &= reply->smatrix.checksum == crc8(reply->smatrix.matrix, sizeof(reply->smatrix.matrix));
+    if (okay) {
+        memcpy(batch_last_matrix, reply->smatrix.matrix, sizeof(batch_last_matrix));
+    }
+    // A frame the slave rejected counts as a failed exchange, so that its writes are retried
+    okay &= size == 0 || reply->frame_checksum == frame[0];
+    transaction_batch_complete(okay);
+    return okay;
+}
+
+#    ifdef SPLIT_TRANSACTION_ASYNC
+
+/*
+ * The frame is exchanged in the background while the main loop carries on scanning. The frame stays in place until
+ * the exchange completes, and nothing new is queued in the meantime, so the slave matrix lags by however many scans
+ * the exchange takes.
+ */
+
+static bool           batch_in_flight = false;
+static int8_t         batch_flight_id;
+static const uint8_t *batch_flight_frame;
+static uint8_t        batch_flight_size;
+
+// Returns false while the exchange started on an earlier scan is still in progress
+static bool batch_collect(matrix_row_t slave_matrix[], bool *okay) {
+    if (batch_in_flight) {
+        split_batch_reply_t reply;
+        bool                success;
+        if (!transport_finish_transaction(batch_flight_id, &reply, sizeof(reply), &success)) {
+            memcpy(slave_matrix, batch_last_matrix, sizeof(batch_last_matrix));
+            return false;
+        }
+        batch_in_flight = false;
+        *okay &= batch_acknowledge(success, batch_flight_frame, batch_flight_size, &reply);
+    }
+    memcpy(slave_matrix, batch_last_matrix, sizeof(batch_last_matrix));
+    return true;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_flight_id = transaction_batch_seal(&batch_flight_frame, &batch_flight_size);
+    batch_in_flight = transport_start_transaction(batch_flight_id, batch_flight_frame, batch_flight_size);
+    return batch_in_flight;
+}
+
+#    else // SPLIT_TRANSACTION_ASYNC
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_reply_t reply;
+    const uint8_t      *frame;
+    uint8_t             size;
+    int8_t              id = transaction_batch_seal(&frame, &size);
+
+    bool okay = transport_execute_transaction(id, frame, size, &reply, sizeof(reply));
+    okay      = batch_acknowledge(okay, frame, size, &reply);
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, batch_last_matrix, sizeof(batch_last_matrix));
+    return okay;
+}
+
+#    endif // SPLIT_TRANSACTION_ASYNC
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *frame = initiator2target_buffer;
+    bool           valid = initiator2target_buffer_size > 0 && frame[0] == crc8(&frame[1], initiator2target_buffer_size - 1);
+    // Only apply frames that are well-formed all the way through
+    if (valid && transaction_batch_walk(frame, initiator2target_buffer_size, false, false)) {
+        transaction_batch_walk(frame, initiator2target_buffer_size, true, true);
+        split_shmem->batch_reply.frame_checksum = frame[0];
+    } else if (initiator2target_buffer_size > 0) {
+        split_shmem->batch_reply.frame_checksum = ~frame[0];
+    }
+    memcpy(&split_shmem->batch_reply.smatrix, &split_shmem->smatrix, sizeof(split_shmem->smatrix));
+}
+
+#    define trans_batch_initializer(size) \
+        { size, offsetof(split_shared_memory_t, batch), sizeof_member(split_shared_memory_t, batch_reply), offsetof(split_shared_memory_t, batch_reply), batch_handlers_slave }
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH_EMPTY]  = trans_batch_initializer(0), \
+    [EXCHANGE_BATCH_SMALL]  = trans_batch_initializer(SPLIT_TRANSACTION_BATCH_SIZE / 4), \
+    [EXCHANGE_BATCH_MEDIUM] = trans_batch_initializer(SPLIT_TRANSACTION_BATCH_SIZE / 2), \
+    [EXCHANGE_BATCH_LARGE]  = trans_batch_initializer(SPLIT_TRANSACTION_BATCH_SIZE),
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -753,7 +895,9 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     last_exec = timer_read32();
 #    endif
 
+    pointing_device_driver_lock();
     uint16_t temp_cpi = !pointing_device_driver->get_cpi ? 0 : pointing_device_driver->get_cpi(); // check for NULL
+    pointing_device_driver_unlock();
 
     split_shared_memory_lock();
     split_slave_pointing_sync_t pointing;
@@ -761,10 +905,17 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     split_shared_memory_unlock();
 
     if (pointing.cpi && pointing.cpi != temp_cpi && pointing_device_driver->set_cpi) {
+        pointing_device_driver_lock();
         pointing_device_driver->set_cpi(pointing.cpi);
+        pointing_device_driver_unlock();
     }
 
+#    ifdef POINTING_DEVICE_MOTION_INTERRUPT
+    // Carry over the buttons, only the ones the sensor changed are updated
+    pointing.report = pointing_device_motion_get_report((report_mouse_t){.buttons = pointing.report.buttons});
+#    else
     pointing.report = pointing_device_driver->get_report((report_mouse_t){0});
+#    endif
     // Now update the checksum given that the pointing has been written to
     pointing.checksum = crc8(&pointing.report, sizeof(report_mouse_t));
 
@@ -926,6 +1077,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
@@ -954,8 +1106,10 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifndef SPLIT_TRANSACTION_BATCH
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
+#endif // SPLIT_TRANSACTION_BATCH
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
@@ -977,6 +1131,28 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    bool okay = true;
+#    ifdef SPLIT_TRANSACTION_ASYNC
+    // Nothing new is queued until the previous exchange has completed
+    if (!batch_collect(slave_matrix, &okay)) {
+        return true;
+    }
+#    endif // SPLIT_TRANSACTION_ASYNC
+
+    batch_active = true;
+    okay &= transactions_master_handlers(master_matrix, slave_matrix);
+    batch_active = false;
+
+    // Whatever was queued before any failure still goes out, along with the slave matrix
+    TRANSACTIONS_BATCH_MASTER();
+    return okay;
+#else  // SPLIT_TRANSACTION_BATCH
+    return transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSACTION_BATCH
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -119,6 +119,32 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSACTION_ASYNC
+bool transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    return soft_serial_transaction_start(id);
+}
+
+bool transport_finish_transaction(int8_t id, void *target2initiator_buf, uint16_t target2initiator_length, bool *success) {
+    if (!soft_serial_transaction_finished(success)) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (*success && target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+#    endif // SPLIT_TRANSACTION_ASYNC
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -31,6 +31,19 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_TRANSACTION_BATCH
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE 32
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+_Static_assert(SPLIT_TRANSACTION_BATCH_SIZE >= 16 && SPLIT_TRANSACTION_BATCH_SIZE <= 255, "SPLIT_TRANSACTION_BATCH_SIZE must be between 16 and 255");
+#endif // SPLIT_TRANSACTION_BATCH
+
+#ifdef SPLIT_TRANSACTION_ASYNC
+#    if !defined(SPLIT_TRANSACTION_BATCH) || defined(USE_I2C) || !defined(PROTOCOL_CHIBIOS) || defined(SERIAL_DRIVER_BITBANG)
+#        error "SPLIT_TRANSACTION_ASYNC requires SPLIT_TRANSACTION_BATCH and the ChibiOS usart or vendor serial driver"
+#    endif
+#endif // SPLIT_TRANSACTION_ASYNC
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +53,13 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSACTION_ASYNC
+// Starts a transaction without waiting for it to complete, returns false if one is still in progress
+bool transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// Returns true once the started transaction has completed, with its outcome in success
+bool transport_finish_transaction(int8_t id, void *target2initiator_buf, uint16_t target2initiator_length, bool *success);
+#endif // SPLIT_TRANSACTION_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -57,6 +77,13 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_TRANSACTION_BATCH
+typedef struct _split_batch_reply_t {
+    uint8_t                   frame_checksum; // checksum of the frame the slave has just applied
+    split_slave_matrix_sync_t smatrix;
+} split_batch_reply_t;
+#endif // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -154,6 +181,11 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    uint8_t             batch[SPLIT_TRANSACTION_BATCH_SIZE];
+    split_batch_reply_t batch_reply;
+#endif // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -31,6 +31,7 @@
 #include "matrix.h"
 #include "timer.h"
 #include "wait.h"
+#include "util.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
 #if defined(AUDIO_ENABLE)
@@ -436,6 +437,31 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef VIA_DYNAMIC_KEYMAP_BUFFER_EXTENSIONS
+        case id_dynamic_keymap_get_buffer_crc: {
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint16_t size   = (command_data[2] << 8) | command_data[3];
+            uint16_t crc    = dynamic_keymap_get_buffer_crc(offset, size);
+            command_data[4] = crc >> 8;
+            command_data[5] = crc & 0xFF;
+            break;
+        }
+        case id_dynamic_keymap_get_buffer_rle: {
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint16_t count  = dynamic_keymap_get_buffer_rle(offset, length - 6, &command_data[5], &command_data[4]);
+            command_data[2] = count >> 8;
+            command_data[3] = count & 0xFF;
+            break;
+        }
+        case id_dynamic_keymap_set_buffer_rle: {
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint8_t  size   = MIN(command_data[2], length - 4);
+            uint16_t count  = dynamic_keymap_set_buffer_rle(offset, size, &command_data[3]);
+            command_data[2] = count >> 8;
+            command_data[3] = count & 0xFF;
+            break;
+        }
+#endif
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
@@ -93,9 +93,24 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+#ifdef VIA_DYNAMIC_KEYMAP_BUFFER_EXTENSIONS
+    // Not part of the VIA protocol, see below
+    id_dynamic_keymap_get_buffer_crc        = 0xE0,
+    id_dynamic_keymap_get_buffer_rle        = 0xE1,
+    id_dynamic_keymap_set_buffer_rle        = 0xE2,
+#endif
     id_unhandled                            = 0xFF,
 };
 
+// With VIA_DYNAMIC_KEYMAP_BUFFER_EXTENSIONS defined, host applications other than VIA Configurator can sync the keymap
+// through these commands, whose IDs are outside the range VIA uses. All values are big-endian, and the replies echo the
+// request with the fields below filled in (see dynamic_keymap.h for the token format):
+//   id_dynamic_keymap_get_buffer_crc: offset[2] size[2] -> crc[2]
+//   id_dynamic_keymap_get_buffer_rle: offset[2] -> count[2] length[1] tokens[length], count keycodes from offset
+//   id_dynamic_keymap_set_buffer_rle: offset[2] length[1] tokens[length] -> count[2] in place of length and the first
+//                                     token byte, the number of keycodes written or 0 if the tokens were rejected
+// Each command is a single request and reply; larger transfers are a sequence of them at increasing offsets.
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
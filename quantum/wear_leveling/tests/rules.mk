@@ -63,4 +63,20 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_write_cache_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32 \
+	-DWEAR_LEVELING_WRITE_CACHE \
+	-DEEPROM_WEAR_LEVELING
+wear_leveling_write_cache_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_wear_leveling.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_write_cache.cpp
+wear_leveling_write_cache_INC := \
+	$(wear_leveling_common_INC) \
+	$(DRIVER_PATH)/eeprom
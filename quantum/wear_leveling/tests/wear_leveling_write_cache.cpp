@@ -0,0 +1,147 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+
+void advance_time(uint32_t ms);
+}
+
+class WearLevelingWriteCache : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+/**
+ * This test verifies that writes only reach the backing store once flushed, but are visible to reads straight away.
+ */
+TEST_F(WearLevelingWriteCache, WritesDeferredUntilFlush) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+    uint8_t read_value = 0;
+
+    EXPECT_EQ(wear_leveling_write(0x02, &test_value, sizeof(test_value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 0) << "Write reached the backing store before flush";
+
+    EXPECT_EQ(wear_leveling_read(0x02, &read_value, sizeof(read_value)), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(read_value, test_value) << "Read did not return the pending value";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 1) << "Flush wrote an incorrect number of log entries";
+    EXPECT_TRUE(inst.is_locked()) << "Flush left the backing store unlocked";
+
+    // Nothing left to write
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 1) << "Second flush wrote to the backing store";
+}
+
+/**
+ * This test verifies that adjacent single-byte writes are merged into as few multibyte log entries as possible.
+ */
+TEST_F(WearLevelingWriteCache, AdjacentWritesMerged) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, LOG_ENTRY_MULTIBYTE_MAX_BYTES> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    for (std::size_t i = 0; i < testvalue.size(); ++i) {
+        EXPECT_EQ(wear_leveling_write(4 + i, &testvalue[i], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Overwriting a pending value doesn't add any further entries
+    testvalue[2] = 0x55;
+    EXPECT_EQ(wear_leveling_write(6, &testvalue[2], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 2) << "Flush did not merge the writes into a single multibyte entry";
+
+    // Playback from the backing store gives back the merged data
+    wear_leveling_init();
+    std::array<std::uint8_t, LOG_ENTRY_MULTIBYTE_MAX_BYTES> readvalue;
+    EXPECT_EQ(wear_leveling_read(4, readvalue.data(), readvalue.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readvalue, testvalue) << "Readback did not match";
+}
+
+/**
+ * This test verifies that separate runs of pending data are written independently, and unflushed data is lost on re-init.
+ */
+TEST_F(WearLevelingWriteCache, SeparateRunsAndUnflushedData) {
+    auto&   inst  = MockBackingStore::Instance();
+    uint8_t value = 0x01;
+
+    EXPECT_EQ(wear_leveling_write(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(20, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 2) << "Flush wrote an incorrect number of log entries";
+
+    value = 0x02;
+    EXPECT_EQ(wear_leveling_write(20, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    wear_leveling_init();
+
+    uint8_t read_value = 0;
+    EXPECT_EQ(wear_leveling_read(20, &read_value, sizeof(read_value)), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(read_value, 0x01) << "Unflushed data survived re-init";
+}
+
+/**
+ * This test verifies that a flush which fills the write log consolidates the cache, including any data still pending.
+ */
+TEST_F(WearLevelingWriteCache, FlushConsolidates) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Each flush of a single byte takes a single log entry
+    std::size_t entries = (WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = 0; i < entries - 1; ++i) {
+        uint8_t value = (uint8_t)(i + 1);
+        EXPECT_EQ(wear_leveling_write(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    }
+    EXPECT_EQ(inst.erasure_count(), 0) << "Backing store consolidated too early";
+
+    // The last entry fills the log, which consolidates both pending runs at once
+    std::array<std::uint8_t, 4> testvalue = {0xAA, 0xBB, 0xCC, 0xDD};
+    EXPECT_EQ(wear_leveling_write(0, &testvalue[0], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(10, &testvalue[1], 3), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Backing store was not consolidated";
+
+    // Nothing is left pending once consolidated
+    auto writes = inst.total_write_count();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.total_write_count(), writes) << "Flush wrote data that was already consolidated";
+
+    wear_leveling_init();
+    std::array<std::uint8_t, 3> readvalue;
+    EXPECT_EQ(wear_leveling_read(10, readvalue.data(), readvalue.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readvalue[0], 0xBB);
+    EXPECT_EQ(readvalue[2], 0xDD);
+}
+
+/**
+ * This test verifies that the EEPROM driver keeps writes pending when a flush fails, and retries them later.
+ */
+TEST_F(WearLevelingWriteCache, DriverRetriesFailedFlush) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+
+    eeprom_write_block(&test_value, (void*)0x02, sizeof(test_value));
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return false; });
+    eeprom_driver_flush();
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 0) << "Failed flush reached the backing store";
+
+    // The retry waits for the idle timeout, rather than hammering the backing store
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+    eeprom_driver_task();
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 0) << "Failed flush was retried straight away";
+
+    advance_time(5000);
+    eeprom_driver_task();
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 1) << "Failed flush was not retried";
+}
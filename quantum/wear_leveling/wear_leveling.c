@@ -61,6 +61,12 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_WRITE_CACHE: If defined, writes only update the cache
+            and are appended to the write log when wear_leveling_flush() is
+            invoked. Bytes written between flushes are tracked individually, and
+            each contiguous run of them is written as the fewest log entries
+            that hold it.
+
     General algorithm:
 
         During initialization:
@@ -76,6 +82,13 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        During writes, with WEAR_LEVELING_WRITE_CACHE:
+            * The cache is updated with the new data, and the bytes marked dirty.
+
+        During flushes, with WEAR_LEVELING_WRITE_CACHE:
+            * Each contiguous run of dirty bytes is appended to the log.
+            * If the log's full, data is consolidated and the write log cleared.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -162,6 +175,9 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_WRITE_CACHE
+    uint8_t dirty[((WEAR_LEVELING_LOGICAL_SIZE) + 7) / 8]; // one bit per byte of the cache not yet written to the backing store
+#endif
 } wear_leveling;
 
 /**
@@ -202,9 +218,34 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
+#ifdef WEAR_LEVELING_WRITE_CACHE
+    memset(wear_leveling.dirty, 0, sizeof(wear_leveling.dirty));
+#endif // WEAR_LEVELING_WRITE_CACHE
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
 }
 
+#ifdef WEAR_LEVELING_WRITE_CACHE
+/**
+ * Write cache helper: marks or clears the supplied range of bytes as pending a write to the backing store.
+ */
+static void wear_leveling_set_dirty(uint32_t address, size_t length, bool dirty) {
+    for (uint32_t end = address + (uint32_t)length; address < end; ++address) {
+        if (dirty) {
+            wear_leveling.dirty[address / 8] |= (uint8_t)(1 << (address % 8));
+        } else {
+            wear_leveling.dirty[address / 8] &= (uint8_t) ~(1 << (address % 8));
+        }
+    }
+}
+
+/**
+ * Write cache helper: checks whether the byte at the supplied address is pending a write to the backing store.
+ */
+static inline bool wear_leveling_is_dirty(uint32_t address) {
+    return wear_leveling.dirty[address / 8] & (1 << (address % 8));
+}
+#endif // WEAR_LEVELING_WRITE_CACHE
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -314,6 +355,12 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
     }
+#ifdef WEAR_LEVELING_WRITE_CACHE
+    else {
+        // Everything pending in the cache is now part of the consolidated data.
+        memset(wear_leveling.dirty, 0, sizeof(wear_leveling.dirty));
+    }
+#endif // WEAR_LEVELING_WRITE_CACHE
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
@@ -691,6 +738,11 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_WRITE_CACHE
+    // Defer the write to the backing store until the next flush
+    wear_leveling_set_dirty(address, length, true);
+    return WEAR_LEVELING_SUCCESS;
+#else  // WEAR_LEVELING_WRITE_CACHE
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -723,8 +775,69 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         }
     }
 
+    return status;
+#endif // WEAR_LEVELING_WRITE_CACHE
+}
+
+#ifdef WEAR_LEVELING_WRITE_CACHE
+/**
+ * Writes any pending data in the cache into the backing store.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    // Skip the unlock/lock cycle if there's nothing to write
+    size_t i = 0;
+    while (i < sizeof(wear_leveling.dirty) && wear_leveling.dirty[i] == 0) {
+        ++i;
+    }
+    if (i == sizeof(wear_leveling.dirty)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Flush\n");
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Write each contiguous run of dirty bytes as a single write
+    wear_leveling_status_t status  = WEAR_LEVELING_SUCCESS;
+    uint32_t               address = i * 8;
+    while (status == WEAR_LEVELING_SUCCESS && address < (WEAR_LEVELING_LOGICAL_SIZE)) {
+        if (!wear_leveling_is_dirty(address)) {
+            ++address;
+            continue;
+        }
+
+        uint32_t end = address + 1;
+        while (end < (WEAR_LEVELING_LOGICAL_SIZE) && wear_leveling_is_dirty(end)) {
+            ++end;
+        }
+
+        // If this consolidates, then the dirty flags have already been cleared. No need to continue.
+        status = wear_leveling_write_raw(address, &wear_leveling.cache[address], end - address);
+        if (status == WEAR_LEVELING_SUCCESS) {
+            wear_leveling_set_dirty(address, end - address, false);
+        }
+        address = end;
+    }
+
+    // Consolidate the cache + write log if required
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidate_if_needed();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
     return status;
 }
+#endif // WEAR_LEVELING_WRITE_CACHE
 
 /**
  * Reads logical data from the cache.
@@ -36,6 +36,9 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * With WEAR_LEVELING_WRITE_CACHE defined, only the cache is updated, and the data is written to the backing store on
+ * the next call to wear_leveling_flush().
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +55,15 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_WRITE_CACHE
+/**
+ * Writes any data pending in the cache into the backing store.
+ *
+ * Adjacent writes made since the last flush are merged, so that each contiguous run of changed bytes is written to the
+ * log as the fewest entries that can hold it.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+#endif // WEAR_LEVELING_WRITE_CACHE
@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class ActionLookupCache : public TestFixture {};
+
+TEST_F(ActionLookupCache, FollowsLayerChanges) {
+    TestDriver driver;
+    KeymapKey  key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_trns = KeymapKey(1, 0, 0, KC_TRNS);
+    KeymapKey  key_c    = KeymapKey(2, 0, 0, KC_C);
+
+    set_keymap({key_a, key_trns, key_c});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ActionLookupCache, FollowsDirectLayerStateWrites) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(1, 0, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    default_layer_state = 0;
+    layer_state         = 0;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    default_layer_state = 1;
+}
+
+TEST_F(ActionLookupCache, ReleaseUsesPressedLayer) {
+    TestDriver driver;
+    KeymapKey  key_mo   = KeymapKey(0, 1, 0, MO(1));
+    KeymapKey  key_trns = KeymapKey(1, 1, 0, KC_TRNS);
+    KeymapKey  key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b    = KeymapKey(1, 0, 0, KC_B);
+
+    set_keymap({key_mo, key_trns, key_a, key_b});
+
+    key_mo.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ActionLookupCache, FollowsKeymapConfigChanges) {
+    TestDriver driver;
+    KeymapKey  key_lctl = KeymapKey(0, 0, 0, KC_LCTL);
+
+    set_keymap({key_lctl});
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_lctl);
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.swap_lctl_lgui = true;
+
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_lctl);
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.swap_lctl_lgui = false;
+}
+
+TEST_F(ActionLookupCache, FollowsKeymapChanges) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    set_keymap({key_b});
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+}
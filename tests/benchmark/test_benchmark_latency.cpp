@@ -0,0 +1,128 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+#include "benchmark_keymap.h"
+
+class Benchmark : public TestFixture {};
+
+TEST_F(Benchmark, plain_typing) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    KeyStream stream = {
+        press_at(0, key_a), release_at(30, key_a), press_at(40, key_b), press_at(60, key_a), release_at(70, key_b), release_at(90, key_a),
+    };
+
+    auto result = replay_key_stream(*this, driver, "plain_typing", stream, 10);
+
+    // Reports go out within the same scan loop as the matrix change
+    EXPECT_EQ(result.unresolved_events, 0);
+    EXPECT_EQ(result.max_latency_ms, 0);
+    EXPECT_EQ(result.max_latency_loops, 1);
+}
+
+TEST_F(Benchmark, tap_hold) {
+    TestDriver driver;
+    auto       key_mt = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+    auto       key_b  = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_mt, key_b});
+
+    KeyStream stream = {
+        // Tap
+        press_at(0, key_mt), release_at(50, key_mt),
+        // Hold past the tapping term
+        press_at(100, key_mt), release_at(400, key_mt),
+        // Rolled tap into a normal key
+        press_at(500, key_mt), press_at(520, key_b), release_at(540, key_mt), release_at(560, key_b),
+    };
+
+    auto result = replay_key_stream(*this, driver, "tap_hold", stream, TAPPING_TERM);
+
+    // The tap-hold decision delays the press by at most the tapping term
+    EXPECT_EQ(result.unresolved_events, 0);
+    EXPECT_LE(result.max_latency_ms, TAPPING_TERM);
+}
+
+TEST_F(Benchmark, combo) {
+    TestDriver driver;
+    auto       key_j = KeymapKey(0, 0, 0, KC_J);
+    auto       key_k = KeymapKey(0, 1, 0, KC_K);
+
+    set_keymap({key_j, key_k});
+
+    KeyStream stream = {
+        // Chord
+        press_at(0, key_j), press_at(5, key_k), release_at(40, key_j), release_at(45, key_k),
+        // Lone key that is part of a combo
+        press_at(100, key_j), release_at(120, key_j),
+        // Lone key held past the combo term
+        press_at(200, key_k), release_at(300, key_k),
+    };
+
+    auto result = replay_key_stream(*this, driver, "combo", stream, COMBO_TERM);
+
+    // Combo candidates are buffered until the combo term has expired, which is
+    // noticed on the scan loop after it has fully elapsed
+    EXPECT_EQ(result.unresolved_events, 0);
+    EXPECT_LE(result.max_latency_ms, COMBO_TERM + 1);
+}
+
+TEST_F(Benchmark, tap_dance) {
+    TestDriver driver;
+    auto       key_td = KeymapKey(0, 0, 0, TD(TD_Q_W));
+
+    set_keymap({key_td});
+
+    KeyStream stream = {
+        // Single tap
+        press_at(0, key_td), release_at(20, key_td),
+        // Double tap
+        press_at(400, key_td), release_at(420, key_td), press_at(440, key_td), release_at(460, key_td),
+    };
+
+    auto result = replay_key_stream(*this, driver, "tap_dance", stream, TAPPING_TERM * 2);
+
+    // A tap dance resolves on the scan loop after the tapping term has fully
+    // elapsed since the last press
+    EXPECT_EQ(result.unresolved_events, 0);
+    EXPECT_LE(result.max_latency_ms, TAPPING_TERM + 1);
+}
+
+TEST_F(Benchmark, key_override) {
+    TestDriver driver;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_bspc  = KeymapKey(0, 1, 0, KC_BSPC);
+
+    set_keymap({key_shift, key_bspc});
+
+    KeyStream stream = {
+        press_at(0, key_shift), press_at(20, key_bspc), release_at(40, key_bspc), release_at(60, key_shift),
+        // Unmodified
+        press_at(100, key_bspc), release_at(120, key_bspc),
+    };
+
+    auto result = replay_key_stream(*this, driver, "key_override", stream, 10);
+
+    // Overrides are applied synchronously
+    EXPECT_EQ(result.unresolved_events, 0);
+    EXPECT_EQ(result.max_latency_ms, 0);
+}
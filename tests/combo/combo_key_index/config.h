@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Fits the generated combos, but not once the padding combos are added
+#define COMBO_KEY_INDEX_LENGTH 1300
@@ -0,0 +1,94 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <tuple>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+extern "C" uint16_t combo_key_index_test_setup(void);
+
+static uint16_t combo_test_count = 0;
+
+extern "C" uint16_t combo_count(void) {
+    return combo_test_count;
+}
+
+typedef std::tuple<uint32_t, uint8_t, std::vector<uint8_t>> report_trace_entry_t;
+
+class ComboKeyIndex : public TestFixture {
+   protected:
+    /* Replays a random stream of overlapping presses and releases, and returns every report sent. */
+    std::vector<report_trace_entry_t> replay(unsigned seed, bool padding) {
+        TestDriver                        driver;
+        std::vector<report_trace_entry_t> trace;
+        std::vector<KeymapKey>            keys;
+        std::vector<bool>                 pressed(10, false);
+        std::mt19937                      rng(seed);
+
+        /* Start every replay at the same time, as the combo timer treats 0 as unset */
+        timer_clear();
+
+        uint16_t chords  = combo_key_index_test_setup();
+        combo_test_count = padding ? combo_count_raw() : chords;
+        for (uint8_t i = 0; i < 10; i++) {
+            keys.emplace_back(0, i, 0, KC_A + i);
+        }
+        set_keymap({keys[0], keys[1], keys[2], keys[3], keys[4], keys[5], keys[6], keys[7], keys[8], keys[9]});
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) {
+            trace.emplace_back(timer_read32(), report.mods, std::vector<uint8_t>(std::begin(report.keys), std::end(report.keys)));
+        }));
+
+        for (int event = 0; event < 300; event++) {
+            uint8_t key = rng() % keys.size();
+            if (pressed[key]) {
+                keys[key].release();
+            } else {
+                keys[key].press();
+            }
+            pressed[key] = !pressed[key];
+            run_one_scan_loop();
+            idle_for(rng() % (COMBO_TERM + 20));
+        }
+        for (uint8_t key = 0; key < keys.size(); key++) {
+            if (pressed[key]) {
+                keys[key].release();
+                run_one_scan_loop();
+            }
+        }
+        idle_for(COMBO_TERM * 2);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        return trace;
+    }
+};
+
+TEST_F(ComboKeyIndex, matches_linear_scan) {
+    for (unsigned seed = 1; seed <= 8; seed++) {
+        std::vector<report_trace_entry_t> indexed = replay(seed, false);
+        std::vector<report_trace_entry_t> linear  = replay(seed, true);
+
+        bool combo_fired = false;
+        for (auto& entry : indexed) {
+            for (uint8_t key : std::get<2>(entry)) {
+                combo_fired |= key >= KC_1 && key <= KC_0;
+            }
+        }
+        EXPECT_TRUE(combo_fired) << "seed " << seed;
+        EXPECT_EQ(indexed, linear) << "seed " << seed;
+    }
+}
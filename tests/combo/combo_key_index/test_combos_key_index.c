@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+/* Every 2, 3 and 4 key chord of KC_A..KC_J, followed by padding combos on
+ * keys which are never pressed. The padding overflows the combo key index,
+ * forcing process_combo() back onto the linear scan. */
+#define COMBO_KEYS 10
+#define COMBO_CHORD_COUNT (45 + 120 + 210)
+#define COMBO_PADDING_COUNT 60
+
+static uint16_t combo_chords[COMBO_CHORD_COUNT + COMBO_PADDING_COUNT][5];
+combo_t         key_combos[COMBO_CHORD_COUNT + COMBO_PADDING_COUNT];
+
+/* Fills in key_combos, and returns the number of combos before the padding. */
+uint16_t combo_key_index_test_setup(void) {
+    uint16_t count = 0;
+    for (uint8_t length = 2; length <= 4; length++) {
+        for (uint16_t mask = 0; mask < (1 << COMBO_KEYS); mask++) {
+            if (__builtin_popcount(mask) != length) {
+                continue;
+            }
+            uint8_t key = 0;
+            for (uint8_t i = 0; i < COMBO_KEYS; i++) {
+                if (mask & (1 << i)) {
+                    combo_chords[count][key++] = KC_A + i;
+                }
+            }
+            combo_chords[count][key] = COMBO_END;
+            key_combos[count]        = (combo_t)COMBO(combo_chords[count], KC_1 + (count % 10));
+            count++;
+        }
+    }
+    for (uint16_t i = 0; i < COMBO_PADDING_COUNT; i++, count++) {
+        combo_chords[count][0] = KC_F13 + (i % 12);
+        combo_chords[count][1] = KC_F13 + ((i + 1) % 12);
+        combo_chords[count][2] = COMBO_END;
+        key_combos[count]      = (combo_t)COMBO(combo_chords[count], KC_F1);
+    }
+    return COMBO_CHORD_COUNT;
+}
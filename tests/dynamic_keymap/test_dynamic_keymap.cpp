@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+class DynamicKeymap : public TestFixture {
+   public:
+    // Reads the keycode back from EEPROM, as it would be after a reboot
+    static uint16_t stored_keycode(uint8_t row, uint8_t column) {
+        const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(0, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymap, SetKeycodeIsStored) {
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(stored_keycode(1, 2), KC_A);
+
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_NO);
+    EXPECT_EQ(stored_keycode(1, 2), KC_NO);
+}
+
+TEST_F(DynamicKeymap, ResetAfterFormatRewritesEveryKey) {
+    // Mirror now holds the flash keymap
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_NO);
+
+    // Format the EEPROM underneath the mirror, as eeconfig_init does before resetting the keymap
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+            uint8_t erased[2] = {0xFF, 0xFF};
+            eeprom_write_block(erased, dynamic_keymap_key_to_eeprom_address(0, row, column), sizeof(erased));
+        }
+    }
+
+    dynamic_keymap_reset();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+            EXPECT_EQ(stored_keycode(row, column), KC_NO) << "row " << (int)row << " column " << (int)column;
+        }
+    }
+}
+
+TEST_F(DynamicKeymap, RleRoundTrip) {
+    const uint16_t keycodes[] = {KC_A, KC_B, KC_NO, KC_NO, KC_NO, KC_TRNS, KC_TRNS, KC_C, KC_NO};
+    const uint16_t total      = MATRIX_ROWS * MATRIX_COLS;
+
+    dynamic_keymap_reset();
+    for (uint16_t i = 0; i < sizeof(keycodes) / sizeof(keycodes[0]); i++) {
+        dynamic_keymap_set_keycode(0, i / MATRIX_COLS, i % MATRIX_COLS, keycodes[i]);
+    }
+    uint16_t crc = dynamic_keymap_get_buffer_crc(0, total * 2);
+
+    uint8_t encoded[64];
+    uint8_t length = 0;
+    EXPECT_EQ(dynamic_keymap_get_buffer_rle(0, sizeof(encoded), encoded, &length), total);
+    // Two literals, then runs of three KC_NO and two KC_TRNS, a literal, and the rest of the keymap as KC_NO
+    const uint8_t expected[] = {0x01, 0x00, KC_A, 0x00, KC_B, 0x82, 0xC1, 0x00, 0x00, KC_C, DYNAMIC_KEYMAP_RLE_NO | (total - 8 - 1)};
+    ASSERT_EQ(length, sizeof(expected));
+    for (uint8_t i = 0; i < length; i++) {
+        EXPECT_EQ(encoded[i], expected[i]) << "byte " << (int)i;
+    }
+
+    dynamic_keymap_reset();
+    EXPECT_NE(dynamic_keymap_get_buffer_crc(0, total * 2), crc);
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle(0, length, encoded), total);
+    EXPECT_EQ(dynamic_keymap_get_buffer_crc(0, total * 2), crc);
+    for (uint16_t i = 0; i < sizeof(keycodes) / sizeof(keycodes[0]); i++) {
+        EXPECT_EQ(stored_keycode(i / MATRIX_COLS, i % MATRIX_COLS), keycodes[i]) << "key " << i;
+    }
+}
+
+TEST_F(DynamicKeymap, RleRejectsMalformedInput) {
+    const uint16_t total = MATRIX_ROWS * MATRIX_COLS;
+    dynamic_keymap_reset();
+    uint16_t crc = dynamic_keymap_get_buffer_crc(0, total * 2);
+
+    // Literal of two keycodes with only one present
+    const uint8_t truncated[] = {0x01, 0x00, KC_A, 0x00};
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle(0, sizeof(truncated), truncated), 0);
+
+    // Runs past the end of the keymap
+    const uint8_t overrun[] = {0x00, 0x00, KC_A, DYNAMIC_KEYMAP_RLE_TRNS | 1};
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle((total - 2) * 2, sizeof(overrun), overrun), 0);
+
+    // Offsets that would wrap around 16 bits, or aren't keycode aligned
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle(0xFFFE, sizeof(overrun), overrun), 0);
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle(1, 3, overrun), 0);
+
+    uint8_t encoded[8];
+    uint8_t length = 0xFF;
+    EXPECT_EQ(dynamic_keymap_get_buffer_rle(1, sizeof(encoded), encoded, &length), 0);
+    EXPECT_EQ(length, 0);
+
+    EXPECT_EQ(dynamic_keymap_get_buffer_crc(0, total * 2), crc);
+    EXPECT_EQ(dynamic_keymap_set_buffer_rle((total - 2) * 2, 3, overrun), 1);
+    EXPECT_EQ(stored_keycode(MATRIX_ROWS - 1, MATRIX_COLS - 2), KC_A);
+}
@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stand-in for the header generated by `qmk generate-keycode-actions-h`
+#pragma once
+
+#define KEYCODE_ACTION_TABLE_SIZE 8
+
+#define KEYCODE_ACTION_TABLE_KEYCODES \
+    KC_A, \
+    KC_LCTL, \
+    LCTL_T(KC_B), \
+    MO(1), \
+    KC_TRNS, \
+    KC_A,
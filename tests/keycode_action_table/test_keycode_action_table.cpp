@@ -0,0 +1,78 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keycode_action_table.h"
+}
+
+using testing::_;
+
+class KeycodeActionTable : public TestFixture {};
+
+TEST_F(KeycodeActionTable, ResolvesListedKeycodes) {
+    action_t action;
+
+    for (uint16_t keycode : std::initializer_list<uint16_t>{KC_A, KC_LCTL, LCTL_T(KC_B), MO(1), KC_TRNS}) {
+        EXPECT_TRUE(keycode_action_table_lookup(keycode, &action));
+        EXPECT_EQ(action.code, action_for_keycode_raw(keycode).code);
+        EXPECT_EQ(action_for_keycode(keycode).code, action_for_keycode_raw(keycode).code);
+    }
+}
+
+TEST_F(KeycodeActionTable, FallsBackForUnlistedKeycodes) {
+    action_t action;
+
+    EXPECT_FALSE(keycode_action_table_lookup(KC_NO, &action));
+    EXPECT_FALSE(keycode_action_table_lookup(KC_Z, &action));
+    EXPECT_FALSE(keycode_action_table_lookup(MO(2), &action));
+    EXPECT_EQ(action_for_keycode(KC_Z).code, action_for_keycode_raw(KC_Z).code);
+    EXPECT_EQ(action_for_keycode(MO(2)).code, action_for_keycode_raw(MO(2)).code);
+}
+
+TEST_F(KeycodeActionTable, FollowsKeymapConfig) {
+    TestDriver driver;
+    KeymapKey  key_lctl = KeymapKey(0, 0, 0, KC_LCTL);
+
+    set_keymap({key_lctl});
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_lctl);
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.swap_lctl_lgui = true;
+
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_lctl);
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.swap_lctl_lgui = false;
+}
+
+TEST_F(KeycodeActionTable, ModTapFromTable) {
+    TestDriver driver;
+    KeymapKey  key_mt = KeymapKey(0, 0, 0, LCTL_T(KC_B));
+    KeymapKey  key_mo = KeymapKey(0, 1, 0, MO(1));
+    KeymapKey  key_a  = KeymapKey(1, 0, 0, KC_A);
+
+    set_keymap({key_mt, key_mo, key_a});
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_mt);
+    VERIFY_AND_CLEAR(driver);
+
+    key_mo.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    EXPECT_NO_REPORT(driver);
+    key_mo.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "matrix.h"
+}
+
+using testing::_;
+
+static unsigned idle_wait_count = 0;
+
+extern "C" void matrix_idle_wait(void) {
+    idle_wait_count++;
+}
+
+class MatrixIdleWakeup : public TestFixture {
+   public:
+    // Runs scan loops the way the main loop does, with the idle hook after every other task
+    void idle_loops(unsigned loops) {
+        for (unsigned i = 0; i < loops; i++) {
+            run_one_scan_loop();
+            matrix_idle_task();
+        }
+    }
+};
+
+TEST_F(MatrixIdleWakeup, IdlesOnlyAfterTheMatrixHasBeenReleasedForTheDelay) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    idle_loops(1);
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    idle_loops(1);
+    VERIFY_AND_CLEAR(driver);
+
+    idle_wait_count = 0;
+    idle_loops(MATRIX_IDLE_WAKEUP_DELAY - 2);
+    EXPECT_EQ(idle_wait_count, 0);
+
+    idle_loops(2);
+    EXPECT_GT(idle_wait_count, 0);
+}
+
+TEST_F(MatrixIdleWakeup, DoesNotIdleWhileAKeyIsHeld) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    idle_loops(1);
+    VERIFY_AND_CLEAR(driver);
+
+    idle_wait_count = 0;
+    idle_loops(MATRIX_IDLE_WAKEUP_DELAY * 4);
+    EXPECT_EQ(idle_wait_count, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    idle_loops(1);
+    VERIFY_AND_CLEAR(driver);
+}
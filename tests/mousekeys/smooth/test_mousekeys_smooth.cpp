@@ -0,0 +1,156 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class MousekeySmooth : public TestFixture {};
+
+TEST_F(MousekeySmooth, PressAndHoldCursorRightMovesEveryLoop) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  mouse_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+
+    set_keymap({accel_key, mouse_key});
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    accel_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (80, 0, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing moves until MOUSEKEY_DELAY has passed
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(MOUSEKEY_DELAY - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Maximum speed is 80 counts every 20ms
+    EXPECT_MOUSE_REPORT(driver, (4, 0, 0, 0, 0)).Times(3);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver).Times(2);
+    mouse_key.release();
+    run_one_scan_loop();
+    accel_key.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeySmooth, PressAndHoldWheelUpCarriesFractionsOver) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_0};
+    KeymapKey  mouse_key = KeymapKey{0, 1, 0, QK_MOUSE_WHEEL_UP};
+
+    set_keymap({accel_key, mouse_key});
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    accel_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 2, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // A quarter of the maximum speed is 2 steps every 80ms, so one step every 40ms
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(MOUSEKEY_WHEEL_DELAY - 1 + 39);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(39);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver).Times(2);
+    mouse_key.release();
+    run_one_scan_loop();
+    accel_key.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeySmooth, DiagonalMovementKeepsFractions) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  right_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+    KeymapKey  down_key  = KeymapKey{0, 2, 0, QK_MOUSE_CURSOR_DOWN};
+    int        x         = 0;
+    int        y         = 0;
+
+    set_keymap({accel_key, right_key, down_key});
+
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+    accel_key.press();
+    run_one_scan_loop();
+    right_key.press();
+    down_key.press();
+    run_one_scan_loop();
+    idle_for(MOUSEKEY_DELAY - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_MOUSE_REPORT(driver).WillRepeatedly(Invoke([&](report_mouse_t &report) {
+        x += report.x;
+        y += report.y;
+    }));
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    // 4 counts per loop, times 181/256 for diagonals
+    EXPECT_EQ(x, 282);
+    EXPECT_EQ(y, 282);
+
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+    right_key.release();
+    down_key.release();
+    accel_key.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeySmooth, PressAndHoldCursorUpReachesMaximumSpeed) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_UP};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (0, -8, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+    idle_for(MOUSEKEY_DELAY + MOUSEKEY_TIME_TO_MAX * MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, -4, 0, 0, 0)).Times(2);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    mouse_key.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+struct SimpleReport {
+    int16_t x;
+    int16_t y;
+};
+
+class Pointing : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Drops the fractions of a count left over by the previous test
+        pointing_device_init();
+    }
+};
+class PointingAccelCurveParametrized : public ::testing::WithParamInterface<std::pair<SimpleReport, SimpleReport>>, public Pointing {};
+
+TEST_P(PointingAccelCurveParametrized, PointingAccelCurve) {
+    TestDriver   driver;
+    SimpleReport input        = GetParam().first;
+    SimpleReport expectations = GetParam().second;
+
+    pd_set_x(input.x);
+    pd_set_y(input.y);
+
+    EXPECT_MOUSE_REPORT(driver, (expectations.x, expectations.y, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Speeds,
+    PointingAccelCurveParametrized,
+    ::testing::Values(
+        //                      Input                  Expected
+        std::make_pair(SimpleReport{  2,   0}, SimpleReport{  2,   0}), // gain 1.25
+        std::make_pair(SimpleReport{  4,   0}, SimpleReport{  6,   0}), // gain 1.5
+        std::make_pair(SimpleReport{  0,  -4}, SimpleReport{  0,  -6}), // gain 1.5
+        std::make_pair(SimpleReport{  4,   4}, SimpleReport{  7,   7}), // speed 6, gain 1.75
+        std::make_pair(SimpleReport{ 20, -10}, SimpleReport{ 40, -20})  // past the curve, gain 2
+        ));
+// clang-format on
@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class PointingMotionScale : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Drops the fractions of a count left over by the previous test
+        pointing_device_init();
+    }
+};
+
+TEST_F(PointingMotionScale, ScalesMotion) {
+    TestDriver driver;
+
+    pd_set_x(10);
+    pd_set_y(-20);
+    EXPECT_MOUSE_REPORT(driver, (15, -30, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionScale, CarriesFractionsOver) {
+    TestDriver driver;
+
+    // 1.5 counts are reported as 1, the remaining half is added to the next report
+    pd_set_x(1);
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (2, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionScale, CarriesNegativeFractionsOver) {
+    TestDriver driver;
+
+    pd_set_y(-1);
+    EXPECT_MOUSE_REPORT(driver, (0, -1, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, -2, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionScale, SplitsOversizedMotion) {
+    TestDriver driver;
+
+    // 150 counts don't fit into a single report
+    pd_set_x(100);
+    EXPECT_MOUSE_REPORT(driver, (127, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    EXPECT_MOUSE_REPORT(driver, (23, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
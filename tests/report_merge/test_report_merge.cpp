@@ -0,0 +1,236 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "report.h"
+}
+
+class ReportMerge : public TestFixture {};
+
+static report_keyboard_t keyboard(uint8_t mods, uint8_t key0 = KC_NO, uint8_t key1 = KC_NO) {
+    report_keyboard_t report = {};
+    report.mods              = mods;
+    report.keys[0]           = key0;
+    report.keys[1]           = key1;
+    return report;
+}
+
+TEST_F(ReportMerge, KeyboardMergesFurtherPresses) {
+    report_keyboard_t last    = keyboard(0);
+    report_keyboard_t pending = keyboard(0, KC_A);
+    report_keyboard_t report  = keyboard(MOD_BIT(KC_LEFT_SHIFT), KC_A, KC_B);
+
+    EXPECT_TRUE(merge_keyboard_report(&pending, &last, &report));
+    EXPECT_EQ(memcmp(&pending, &report, sizeof(report)), 0);
+}
+
+TEST_F(ReportMerge, KeyboardKeepsPressThatIsReleasedAgain) {
+    report_keyboard_t last    = keyboard(0);
+    report_keyboard_t pending = keyboard(0, KC_A);
+    report_keyboard_t report  = keyboard(0);
+
+    EXPECT_FALSE(merge_keyboard_report(&pending, &last, &report));
+    EXPECT_EQ(pending.keys[0], KC_A);
+}
+
+TEST_F(ReportMerge, KeyboardKeepsReleaseThatIsPressedAgain) {
+    report_keyboard_t last    = keyboard(0, KC_A);
+    report_keyboard_t pending = keyboard(0);
+    report_keyboard_t report  = keyboard(0, KC_A);
+
+    EXPECT_FALSE(merge_keyboard_report(&pending, &last, &report));
+}
+
+TEST_F(ReportMerge, KeyboardKeepsModifierThatChangesBack) {
+    report_keyboard_t last    = keyboard(0);
+    report_keyboard_t pending = keyboard(MOD_BIT(KC_LEFT_CTRL));
+    report_keyboard_t report  = keyboard(0, KC_C);
+
+    EXPECT_FALSE(merge_keyboard_report(&pending, &last, &report));
+}
+
+TEST_F(ReportMerge, KeyboardMergesKeyMovingSlot) {
+    report_keyboard_t last    = keyboard(0, KC_A, KC_B);
+    report_keyboard_t pending = keyboard(0, KC_B);
+    report_keyboard_t report  = keyboard(0, KC_C, KC_B);
+
+    EXPECT_TRUE(merge_keyboard_report(&pending, &last, &report));
+}
+
+TEST_F(ReportMerge, NkroMergesOnlyWithoutLostTransitions) {
+    report_nkro_t last = {}, pending = {}, report = {};
+    pending.bits[0] = 0x01;
+    report.bits[0]  = 0x03;
+    EXPECT_TRUE(merge_nkro_report(&pending, &last, &report));
+    EXPECT_EQ(pending.bits[0], 0x03);
+
+    pending.bits[0] = 0x01;
+    report.bits[0]  = 0x02;
+    EXPECT_FALSE(merge_nkro_report(&pending, &last, &report));
+    EXPECT_EQ(pending.bits[0], 0x01);
+
+    pending.bits[0] = 0x00;
+    pending.mods    = MOD_BIT(KC_LEFT_ALT);
+    report.mods     = 0;
+    EXPECT_FALSE(merge_nkro_report(&pending, &last, &report));
+}
+
+TEST_F(ReportMerge, MouseAccumulatesMotion) {
+    report_mouse_t pending = {}, report = {};
+    pending.x = 10;
+    pending.v = -1;
+    report.x  = 5;
+    report.y  = -3;
+    report.v  = -1;
+
+    EXPECT_TRUE(merge_mouse_report(&pending, &report));
+    EXPECT_EQ(pending.x, 15);
+    EXPECT_EQ(pending.y, -3);
+    EXPECT_EQ(pending.v, -2);
+}
+
+TEST_F(ReportMerge, MouseKeepsButtonChanges) {
+    report_mouse_t pending = {}, report = {};
+    report.buttons = 1;
+    report.x       = 1;
+
+    EXPECT_FALSE(merge_mouse_report(&pending, &report));
+    EXPECT_EQ(pending.x, 0);
+}
+
+TEST_F(ReportMerge, MouseKeepsMotionThatNoLongerFits) {
+    report_mouse_t pending = {}, report = {};
+    pending.x = 100;
+    report.x  = 100;
+
+    EXPECT_FALSE(merge_mouse_report(&pending, &report));
+    EXPECT_EQ(pending.x, 100);
+}
+
+class ReportQueue : public ReportMerge {
+   protected:
+    void SetUp() override {
+        report_queue_clear(&queue);
+    }
+
+    void push_keyboard(report_keyboard_t report, bool expected = true) {
+        report_queue_entry_t entry = {};
+        entry.kind                 = REPORT_QUEUE_KEYBOARD;
+        entry.size                 = sizeof(report);
+        entry.report.keyboard      = report;
+        EXPECT_EQ(report_queue_push(&queue, &entry), expected);
+    }
+
+    void push_mouse(int8_t x, uint8_t buttons = 0) {
+        report_queue_entry_t entry = {};
+        entry.kind                 = REPORT_QUEUE_MOUSE;
+        entry.size                 = sizeof(report_mouse_t);
+        entry.report.mouse.x       = x;
+        entry.report.mouse.buttons = buttons;
+        EXPECT_TRUE(report_queue_push(&queue, &entry));
+    }
+
+    void push_other(uint8_t value) {
+        report_queue_entry_t entry = {};
+        entry.kind                 = REPORT_QUEUE_OTHER;
+        entry.size                 = 1;
+        memcpy(&entry.report, &value, 1);
+        EXPECT_TRUE(report_queue_push(&queue, &entry));
+    }
+
+    // Pops the oldest report, which has to be a keyboard report holding `key` in its first slot
+    void expect_keyboard(uint8_t key) {
+        report_queue_entry_t *entry = report_queue_peek(&queue);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->kind, REPORT_QUEUE_KEYBOARD);
+        EXPECT_EQ(entry->report.keyboard.keys[0], key);
+        report_queue_pop(&queue);
+    }
+
+    report_queue_t queue;
+};
+
+TEST_F(ReportQueue, KeepsTapWithinOnePollInterval) {
+    push_keyboard(keyboard(0, KC_A));
+    push_keyboard(keyboard(0));
+
+    EXPECT_EQ(queue.count, 2);
+    EXPECT_EQ(queue.overflows, 0);
+    expect_keyboard(KC_A);
+    expect_keyboard(KC_NO);
+    EXPECT_EQ(report_queue_peek(&queue), nullptr);
+}
+
+TEST_F(ReportQueue, MergesFurtherPresses) {
+    push_keyboard(keyboard(0, KC_A));
+    push_keyboard(keyboard(0, KC_A, KC_B));
+
+    EXPECT_EQ(queue.count, 1);
+    EXPECT_EQ(report_queue_peek(&queue)->report.keyboard.keys[1], KC_B);
+}
+
+TEST_F(ReportQueue, MergesAgainstPreviousQueuedReport) {
+    // A is released and pressed again behind the tap, so the last two reports can't be merged
+    push_keyboard(keyboard(0, KC_A));
+    push_keyboard(keyboard(0));
+    push_keyboard(keyboard(0, KC_A));
+
+    EXPECT_EQ(queue.count, 3);
+    expect_keyboard(KC_A);
+    expect_keyboard(KC_NO);
+    expect_keyboard(KC_A);
+}
+
+TEST_F(ReportQueue, MergesAgainstLastSentReport) {
+    report_queue_entry_t sent = {};
+    sent.kind                 = REPORT_QUEUE_KEYBOARD;
+    sent.report.keyboard      = keyboard(0, KC_A);
+    report_queue_sent(&queue, &sent);
+
+    push_keyboard(keyboard(0));
+    push_keyboard(keyboard(0, KC_A));
+
+    EXPECT_EQ(queue.count, 2);
+}
+
+TEST_F(ReportQueue, MergesMouseMotion) {
+    push_mouse(10);
+    push_mouse(5);
+    push_mouse(5, 1);
+
+    EXPECT_EQ(queue.count, 2);
+    EXPECT_EQ(report_queue_peek(&queue)->report.mouse.x, 15);
+}
+
+TEST_F(ReportQueue, KeepsOrderBetweenKinds) {
+    push_mouse(10);
+    push_other(0x42);
+    push_mouse(5);
+
+    ASSERT_EQ(queue.count, 3);
+    EXPECT_EQ(report_queue_peek(&queue)->report.mouse.x, 10);
+    report_queue_pop(&queue);
+    EXPECT_EQ(report_queue_peek(&queue)->kind, REPORT_QUEUE_OTHER);
+    report_queue_pop(&queue);
+    EXPECT_EQ(report_queue_peek(&queue)->report.mouse.x, 5);
+}
+
+TEST_F(ReportQueue, CountsOverflows) {
+    for (uint8_t i = 0; i < REPORT_QUEUE_SIZE; i++) {
+        push_keyboard(keyboard(0, i % 2 ? KC_NO : KC_A));
+    }
+    EXPECT_EQ(queue.overflows, 0);
+
+    push_keyboard(keyboard(0, REPORT_QUEUE_SIZE % 2 ? KC_NO : KC_A), false);
+    EXPECT_EQ(queue.overflows, 1);
+    EXPECT_EQ(queue.count, REPORT_QUEUE_SIZE);
+
+    // Sending the oldest report makes room again
+    expect_keyboard(KC_A);
+    push_keyboard(keyboard(0, REPORT_QUEUE_SIZE % 2 ? KC_NO : KC_A));
+    EXPECT_EQ(queue.overflows, 1);
+    EXPECT_EQ(queue.count, REPORT_QUEUE_SIZE);
+}
@@ -0,0 +1,113 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+class ScanProfiler : public TestFixture {
+   public:
+    void SetUp() override {
+        scan_profiler_reset();
+    }
+
+    bool find_stats(const char *name, scan_profiler_stats_t *stats) {
+        for (uint8_t i = 0; i < scan_profiler_task_count(); i++) {
+            if (scan_profiler_get_stats(i, stats) && strcmp(stats->name, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(ScanProfiler, core_tasks_are_profiled) {
+    TestDriver            driver;
+    scan_profiler_stats_t stats;
+
+    EXPECT_NO_REPORT(driver);
+
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+
+    ASSERT_TRUE(find_stats("matrix_task", &stats));
+    EXPECT_EQ(stats.count, 10);
+    EXPECT_LE(stats.min, stats.p50);
+    EXPECT_LE(stats.p50, stats.p99);
+    EXPECT_LE(stats.p99, stats.max);
+
+    ASSERT_TRUE(find_stats("quantum_task()", &stats));
+    EXPECT_EQ(stats.count, 10);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanProfiler, percentiles_use_recent_samples) {
+    TestDriver            driver;
+    scan_profiler_stats_t stats;
+
+    EXPECT_NO_REPORT(driver);
+
+    // Test timer is millisecond based and only moves when advanced
+    for (uint32_t duration = 1; duration <= 10; duration++) {
+        SCAN_PROFILE_NAMED("custom", advance_time(duration));
+    }
+
+    ASSERT_TRUE(find_stats("custom", &stats));
+    EXPECT_EQ(stats.count, 10);
+    EXPECT_EQ(stats.min, 1);
+    EXPECT_EQ(stats.max, 10);
+    // Ring only holds the last 8 samples: 3..10
+    EXPECT_EQ(stats.p50, 6);
+    EXPECT_EQ(stats.p99, 10);
+
+    scan_profiler_reset();
+    ASSERT_TRUE(find_stats("custom", &stats));
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.min, 0);
+    EXPECT_EQ(stats.max, 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanProfiler, serialize) {
+    TestDriver driver;
+    uint8_t    data[32] = {0};
+
+    EXPECT_NO_REPORT(driver);
+
+    run_one_scan_loop();
+
+    EXPECT_EQ(scan_profiler_serialize(scan_profiler_task_count(), data, sizeof(data)), 0);
+    EXPECT_EQ(scan_profiler_serialize(0, data, 8), 0);
+
+    uint8_t length = scan_profiler_serialize(0, data, sizeof(data));
+    EXPECT_GT(length, 22);
+    EXPECT_LE(length, sizeof(data));
+    EXPECT_EQ(data[0], scan_profiler_task_count());
+    EXPECT_EQ(data[1], 0);
+    EXPECT_EQ(data[2] | (data[3] << 8) | (data[4] << 16) | (data[5] << 24), 1);
+    EXPECT_EQ(data[length - 1], 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
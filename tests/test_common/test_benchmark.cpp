@@ -0,0 +1,108 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_benchmark.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using testing::_;
+using testing::Invoke;
+
+std::ostream& operator<<(std::ostream& os, const BenchmarkResult& result) {
+    os << result.name << ": " << result.events << " events (" << result.unresolved_events << " unresolved), " << result.reports << " reports, " << result.loops << " loops, ";
+    os << "latency mean " << std::fixed << std::setprecision(2) << result.mean_latency_ms << "ms max " << result.max_latency_ms << "ms (" << result.max_latency_loops << " loops), ";
+    os << "cpu " << std::setprecision(0) << result.cpu_ns_per_event << "ns/event " << result.cpu_ns_per_loop << "ns/loop";
+    return os;
+}
+
+BenchmarkResult replay_key_stream(TestFixture& fixture, TestDriver& driver, const std::string& name, const KeyStream& stream, uint32_t settle_ms) {
+    BenchmarkResult       result;
+    std::vector<uint32_t> report_times;
+    std::vector<size_t>   report_loops;
+    std::vector<size_t>   event_loops;
+    uint32_t              now  = 0;
+    size_t                loop = 0;
+
+    result.name = name;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t&) {
+        report_times.push_back(now);
+        report_loops.push_back(loop);
+    }));
+
+    const uint32_t           end   = stream.empty() ? settle_ms : stream.back().time_ms + settle_ms;
+    auto                     event = stream.begin();
+    std::chrono::nanoseconds cpu_time{0};
+
+    for (now = 0; now <= end; now++, loop++) {
+        for (; event != stream.end() && event->time_ms <= now; ++event) {
+            EXPECT_EQ(event->time_ms, now) << "key stream events must be sorted by time";
+            KeymapKey key = event->key;
+            if (event->pressed) {
+                key.press();
+            } else {
+                key.release();
+            }
+            event_loops.push_back(loop);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        fixture.run_one_scan_loop();
+        cpu_time += std::chrono::steady_clock::now() - start;
+    }
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    result.events  = stream.size();
+    result.reports = report_times.size();
+    result.loops   = loop;
+
+    uint64_t latency_sum = 0;
+    size_t   report      = 0;
+    for (size_t i = 0; i < stream.size(); i++) {
+        while (report < report_loops.size() && report_loops[report] < event_loops[i]) {
+            report++;
+        }
+        if (report == report_loops.size()) {
+            result.unresolved_events++;
+            continue;
+        }
+        uint32_t latency_ms       = report_times[report] - stream[i].time_ms;
+        size_t   latency_loops    = report_loops[report] - event_loops[i] + 1;
+        latency_sum              += latency_ms;
+        result.max_latency_ms    = std::max(result.max_latency_ms, latency_ms);
+        result.max_latency_loops = std::max(result.max_latency_loops, latency_loops);
+    }
+
+    size_t resolved = result.events - result.unresolved_events;
+    if (resolved) {
+        result.mean_latency_ms = (double)latency_sum / resolved;
+    }
+    if (result.events) {
+        result.cpu_ns_per_event = (double)cpu_time.count() / result.events;
+    }
+    if (result.loops) {
+        result.cpu_ns_per_loop = (double)cpu_time.count() / result.loops;
+    }
+
+    std::cout << "[ BENCH    ] " << result << std::endl;
+    testing::Test::RecordProperty(name + "_mean_latency_us", (int)(result.mean_latency_ms * 1000));
+    testing::Test::RecordProperty(name + "_max_latency_ms", (int)result.max_latency_ms);
+    testing::Test::RecordProperty(name + "_cpu_ns_per_event", (int)result.cpu_ns_per_event);
+
+    return result;
+}
@@ -0,0 +1,75 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief A single matrix change within a recorded key stream.
+ */
+struct KeyStreamEvent {
+    uint32_t  time_ms; // offset from the start of the stream
+    KeymapKey key;
+    bool      pressed;
+};
+
+using KeyStream = std::vector<KeyStreamEvent>;
+
+inline KeyStreamEvent press_at(uint32_t time_ms, KeymapKey key) {
+    return KeyStreamEvent{time_ms, key, true};
+}
+
+inline KeyStreamEvent release_at(uint32_t time_ms, KeymapKey key) {
+    return KeyStreamEvent{time_ms, key, false};
+}
+
+/**
+ * @brief Latency and cost figures gathered while replaying a key stream.
+ *
+ * Latency is measured per matrix event, as the time until the next keyboard
+ * report is emitted. Events that are never followed by a report are counted
+ * as unresolved and excluded from the latency figures.
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t      events            = 0;
+    size_t      unresolved_events = 0;
+    size_t      reports           = 0;
+    size_t      loops             = 0;
+    uint32_t    max_latency_ms    = 0;
+    double      mean_latency_ms   = 0;
+    size_t      max_latency_loops = 0;
+    double      cpu_ns_per_event  = 0;
+    double      cpu_ns_per_loop   = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const BenchmarkResult& result);
+
+/**
+ * @brief Replays `stream` through keyboard_task(), one scan loop per simulated
+ * millisecond, and keeps running for `settle_ms` after the last event.
+ *
+ * Events must be sorted by time. The result is printed and recorded as
+ * properties of the current test, so it ends up in `--gtest_output` reports.
+ */
+BenchmarkResult replay_key_stream(TestFixture& fixture, TestDriver& driver, const std::string& name, const KeyStream& stream, uint32_t settle_ms);
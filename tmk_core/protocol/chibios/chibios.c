@@ -204,6 +204,9 @@ void protocol_pre_task(void) {
 void protocol_post_task(void) {
 #ifdef VIRTSER_ENABLE
     virtser_task();
+#endif
+#ifdef USB_NONBLOCKING_REPORTS
+    usb_report_queue_task();
 #endif
     usb_idle_task();
 }
@@ -291,6 +291,30 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     }
 }
 
+/**
+ * @brief Enqueue a single packet into the endpoint output queue, but only if
+ * a free buffer is available right away.
+ *
+ * @return false if the endpoint is not active or its output queue is full
+ */
+bool usb_endpoint_in_try_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size) {
+    osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U) && (size <= endpoint->config.buffer_size));
+
+    output_buffers_queue_t *obqp = &endpoint->obqueue;
+
+    osalSysLock();
+    if (usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE || obqGetEmptyBufferTimeoutS(obqp, TIME_IMMEDIATE) != MSG_OK) {
+        osalSysUnlock();
+        return false;
+    }
+
+    memcpy(obqp->ptr, data, size);
+    obqPostFullBufferS(obqp, size);
+    osalSysUnlock();
+
+    return true;
+}
+
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded) {
     osalDbgCheck(endpoint != NULL);
 
@@ -185,6 +185,7 @@ void usb_endpoint_in_start(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint);
 
 bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout, bool buffered);
+bool usb_endpoint_in_try_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size);
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded);
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint);
 
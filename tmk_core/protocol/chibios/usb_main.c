@@ -13,6 +13,7 @@
 
 #include <ch.h>
 #include <hal.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "usb_main.h"
@@ -31,6 +32,7 @@
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 #include "usb_types.h"
+#include "util.h"
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -442,18 +444,168 @@ static bool receive_report(usb_endpoint_out_lut_t endpoint, void *report, size_t
     return usb_endpoint_out_receive(&usb_endpoints_out[endpoint], (uint8_t *)report, size, TIME_IMMEDIATE);
 }
 
+#ifdef USB_NONBLOCKING_REPORTS
+/* ---------------------------------------------------------
+ *                Non-blocking report queue
+ * ---------------------------------------------------------
+ *
+ * Keyboard, NKRO and mouse reports never wait for the host. A report that
+ * finds the output queue of its endpoint full is put in a small queue of the
+ * endpoint (see `report_queue_t`), which `usb_report_queue_task` empties as
+ * the endpoint frees up.
+ *
+ * Keyboard and NKRO reports are merged into the newest queued report if no
+ * key press or release gets lost on the way, and mouse reports accumulate
+ * their motion as long as the buttons stay the same. Otherwise they are
+ * queued behind it, so that e.g. a tap within one poll interval still reaches
+ * the host as a press and a release. Reports that share an endpoint, such as
+ * extrakey reports, are queued on it as well and leave it in the order they
+ * were sent. Only when a queue is full does its oldest report go out through
+ * the blocking `send_report`.
+ */
+
+#    ifdef SHARED_EP_ENABLE
+static report_queue_t shared_report_queue;
+#    endif
+#    ifndef KEYBOARD_SHARED_EP
+static report_queue_t keyboard_report_queue;
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+static report_queue_t mouse_report_queue;
+#    endif
+
+static report_queue_t *const usb_report_queues[USB_ENDPOINT_IN_COUNT] = {
+#    ifdef SHARED_EP_ENABLE
+    [USB_ENDPOINT_IN_SHARED] = &shared_report_queue,
+#    endif
+#    ifndef KEYBOARD_SHARED_EP
+    [USB_ENDPOINT_IN_KEYBOARD] = &keyboard_report_queue,
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    [USB_ENDPOINT_IN_MOUSE] = &mouse_report_queue,
+#    endif
+};
+
+static bool usb_report_queue_try_send(usb_endpoint_in_lut_t endpoint, const report_queue_entry_t *entry) {
+    return usb_endpoint_in_try_send(&usb_endpoints_in[endpoint], (const uint8_t *)&entry->report + entry->offset, entry->size);
+}
+
+/**
+ * @brief Hand the queued reports of an endpoint to the host, oldest first.
+ *
+ * @param endpoint USB IN endpoint the reports are sent from
+ * @param blocking wait for the endpoint rather than leaving reports queued
+ * @return true if no reports are queued on the endpoint anymore
+ */
+static bool usb_report_queue_drain(usb_endpoint_in_lut_t endpoint, bool blocking) {
+    report_queue_t *queue = usb_report_queues[endpoint];
+    if (queue == NULL) {
+        return true;
+    }
+    if (USB_DRIVER.state != USB_ACTIVE) {
+        report_queue_clear(queue);
+        return true;
+    }
+
+    report_queue_entry_t *entry;
+    while ((entry = report_queue_peek(queue)) != NULL) {
+        if (blocking) {
+            send_report(endpoint, (uint8_t *)&entry->report + entry->offset, entry->size);
+        } else if (!usb_report_queue_try_send(endpoint, entry)) {
+            return false;
+        }
+        report_queue_pop(queue);
+    }
+    return true;
+}
+
+/**
+ * @brief Send a report to the host without waiting for the endpoint. If the
+ * endpoint is busy, the report is queued behind the reports already waiting
+ * for it. Only if the queue is full, its oldest report is sent blocking to
+ * make room.
+ *
+ * @param endpoint USB IN endpoint to send the report from
+ * @param entry the report and how to send it
+ */
+static void usb_report_queue_send(usb_endpoint_in_lut_t endpoint, const report_queue_entry_t *entry) {
+    report_queue_t *queue = usb_report_queues[endpoint];
+
+    if (USB_DRIVER.state != USB_ACTIVE) {
+        report_queue_clear(queue);
+        return;
+    }
+
+    if (usb_report_queue_drain(endpoint, false) && usb_report_queue_try_send(endpoint, entry)) {
+        report_queue_sent(queue, entry);
+        return;
+    }
+
+    while (!report_queue_push(queue, entry)) {
+        report_queue_entry_t *oldest = report_queue_peek(queue);
+        send_report(endpoint, (uint8_t *)&oldest->report + oldest->offset, oldest->size);
+        report_queue_pop(queue);
+    }
+}
+
+void usb_report_queue_task(void) {
+    for (uint8_t i = 0; i < USB_ENDPOINT_IN_COUNT; i++) {
+        usb_report_queue_drain(i, false);
+    }
+}
+#endif
+
+/**
+ * @brief Send a report that isn't merged with others. If its endpoint queues
+ * keyboard, NKRO or mouse reports, it is queued there as well so that it
+ * can't overtake them.
+ *
+ * @param endpoint USB IN endpoint to send the report from
+ * @param report pointer to the report
+ * @param size size of the report
+ */
+static inline void send_report_in_order(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
+#ifdef USB_NONBLOCKING_REPORTS
+    if (usb_report_queues[endpoint] != NULL && size <= sizeof(((report_queue_entry_t *)0)->report)) {
+        report_queue_entry_t entry = {.kind = REPORT_QUEUE_OTHER, .size = size};
+        memcpy(&entry.report, report, size);
+        usb_report_queue_send(endpoint, &entry);
+        return;
+    }
+    usb_report_queue_drain(endpoint, true);
+#endif
+    send_report(endpoint, report, size);
+}
+
 void send_keyboard(report_keyboard_t *report) {
+#ifdef USB_NONBLOCKING_REPORTS
+    report_queue_entry_t entry = {.kind = REPORT_QUEUE_KEYBOARD, .report.keyboard = *report};
+    /* If we're in Boot Protocol, don't send any report ID or other funky fields */
+    if (usb_device_state_get_protocol() == USB_PROTOCOL_BOOT) {
+        entry.offset = offsetof(report_keyboard_t, mods);
+        entry.size   = 8;
+    } else {
+        entry.size = KEYBOARD_REPORT_SIZE;
+    }
+    usb_report_queue_send(USB_ENDPOINT_IN_KEYBOARD, &entry);
+#else
     /* If we're in Boot Protocol, don't send any report ID or other funky fields */
     if (usb_device_state_get_protocol() == USB_PROTOCOL_BOOT) {
         send_report(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
     } else {
         send_report(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
     }
+#endif
 }
 
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
+#    ifdef USB_NONBLOCKING_REPORTS
+    report_queue_entry_t entry = {.kind = REPORT_QUEUE_NKRO, .size = sizeof(report_nkro_t), .report.nkro = *report};
+    usb_report_queue_send(USB_ENDPOINT_IN_SHARED, &entry);
+#    else
     send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+#    endif
 #endif
 }
 
@@ -464,7 +616,12 @@ void send_nkro(report_nkro_t *report) {
 
 void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
+#    ifdef USB_NONBLOCKING_REPORTS
+    report_queue_entry_t entry = {.kind = REPORT_QUEUE_MOUSE, .size = sizeof(report_mouse_t), .report.mouse = *report};
+    usb_report_queue_send(USB_ENDPOINT_IN_MOUSE, &entry);
+#    else
     send_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+#    endif
 #endif
 }
 
@@ -475,25 +632,25 @@ void send_mouse(report_mouse_t *report) {
 
 void send_extra(report_extra_t *report) {
 #ifdef EXTRAKEY_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_extra_t));
+    send_report_in_order(USB_ENDPOINT_IN_SHARED, report, sizeof(report_extra_t));
 #endif
 }
 
 void send_programmable_button(report_programmable_button_t *report) {
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_programmable_button_t));
+    send_report_in_order(USB_ENDPOINT_IN_SHARED, report, sizeof(report_programmable_button_t));
 #endif
 }
 
 void send_joystick(report_joystick_t *report) {
 #ifdef JOYSTICK_ENABLE
-    send_report(USB_ENDPOINT_IN_JOYSTICK, report, sizeof(report_joystick_t));
+    send_report_in_order(USB_ENDPOINT_IN_JOYSTICK, report, sizeof(report_joystick_t));
 #endif
 }
 
 void send_digitizer(report_digitizer_t *report) {
 #ifdef DIGITIZER_ENABLE
-    send_report(USB_ENDPOINT_IN_DIGITIZER, report, sizeof(report_digitizer_t));
+    send_report_in_order(USB_ENDPOINT_IN_DIGITIZER, report, sizeof(report_digitizer_t));
 #endif
 }
 
@@ -34,6 +34,11 @@ void restart_usb_driver(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+#ifdef USB_NONBLOCKING_REPORTS
+/* Task to enqueue any keyboard, NKRO and mouse reports that are still pending */
+void usb_report_queue_task(void);
+#endif
+
 /* ---------------
  * USB Event queue
  * ---------------
@@ -208,3 +208,216 @@ __attribute__((weak)) bool has_mouse_report_changed(report_mouse_t* new_report,
     return changed;
 }
 #endif
+
+static bool keyboard_report_has_key(const report_keyboard_t* report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Merges a keyboard report into one that hasn't been sent yet, if
+ * no key press or release gets lost by skipping the pending report.
+ *
+ * @param[in,out] pending report_keyboard_t that hasn't been sent yet
+ * @param[in] last report_keyboard_t that was sent before the pending one
+ * @param[in] report report_keyboard_t that follows the pending one
+ * @return bool true if the pending report now holds the merged report
+ */
+bool merge_keyboard_report(report_keyboard_t* pending, const report_keyboard_t* last, const report_keyboard_t* report) {
+    // A modifier that changes in the pending report must not change back
+    if ((last->mods ^ pending->mods) & ~(last->mods ^ report->mods)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        // Keys pressed in the pending report must still be pressed
+        if (pending->keys[i] != KC_NO && !keyboard_report_has_key(last, pending->keys[i]) && !keyboard_report_has_key(report, pending->keys[i])) {
+            return false;
+        }
+        // Keys released in the pending report must still be released
+        if (last->keys[i] != KC_NO && !keyboard_report_has_key(pending, last->keys[i]) && keyboard_report_has_key(report, last->keys[i])) {
+            return false;
+        }
+    }
+
+    *pending = *report;
+    return true;
+}
+
+/**
+ * @brief Merges an NKRO report into one that hasn't been sent yet, if no key
+ * press or release gets lost by skipping the pending report.
+ *
+ * @param[in,out] pending report_nkro_t that hasn't been sent yet
+ * @param[in] last report_nkro_t that was sent before the pending one
+ * @param[in] report report_nkro_t that follows the pending one
+ * @return bool true if the pending report now holds the merged report
+ */
+bool merge_nkro_report(report_nkro_t* pending, const report_nkro_t* last, const report_nkro_t* report) {
+    // A key or modifier that changes in the pending report must not change back
+    if ((last->mods ^ pending->mods) & ~(last->mods ^ report->mods)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if ((last->bits[i] ^ pending->bits[i]) & ~(last->bits[i] ^ report->bits[i])) {
+            return false;
+        }
+    }
+
+    *pending = *report;
+    return true;
+}
+
+#ifdef MOUSE_ENABLE
+/**
+ * @brief Accumulates the motion of a mouse report into one that hasn't been
+ * sent yet, as long as the buttons stay the same and the motion still fits.
+ *
+ * @param[in,out] pending report_mouse_t that hasn't been sent yet
+ * @param[in] report report_mouse_t that follows the pending one
+ * @return bool true if the pending report now holds the merged report
+ */
+bool merge_mouse_report(report_mouse_t* pending, const report_mouse_t* report) {
+    if (pending->buttons != report->buttons) {
+        return false;
+    }
+
+    int32_t x = (int32_t)pending->x + report->x;
+    int32_t y = (int32_t)pending->y + report->y;
+    int32_t v = (int32_t)pending->v + report->v;
+    int32_t h = (int32_t)pending->h + report->h;
+
+    // Don't merge motion that no longer fits into a single report
+    if (x != (mouse_xy_report_t)x || y != (mouse_xy_report_t)y || v != (mouse_hv_report_t)v || h != (mouse_hv_report_t)h) {
+        return false;
+    }
+
+    pending->x = x;
+    pending->y = y;
+    pending->v = v;
+    pending->h = h;
+#    ifdef MOUSE_EXTENDED_REPORT
+    pending->boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    pending->boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#    endif
+    return true;
+}
+#endif
+
+// Index of the entry that is `age` entries newer than the oldest one
+#define REPORT_QUEUE_INDEX(queue, age) (((queue)->head + (age)) % REPORT_QUEUE_SIZE)
+
+// Finds the report of the kind the host sees before the queued entry at `age`, or NULL if it needs none to merge
+static const report_queue_entry_t* report_queue_previous(report_queue_t* queue, uint8_t kind, uint8_t age) {
+    while (age-- > 0) {
+        const report_queue_entry_t* entry = &queue->entries[REPORT_QUEUE_INDEX(queue, age)];
+        if (entry->kind == kind) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool report_queue_merge(report_queue_t* queue, report_queue_entry_t* pending, const report_queue_entry_t* entry) {
+    const report_queue_entry_t* previous = report_queue_previous(queue, entry->kind, queue->count - 1);
+
+    switch (entry->kind) {
+        case REPORT_QUEUE_KEYBOARD:
+            return merge_keyboard_report(&pending->report.keyboard, previous ? &previous->report.keyboard : &queue->last_keyboard, &entry->report.keyboard);
+#ifdef NKRO_ENABLE
+        case REPORT_QUEUE_NKRO:
+            return merge_nkro_report(&pending->report.nkro, previous ? &previous->report.nkro : &queue->last_nkro, &entry->report.nkro);
+#endif
+#ifdef MOUSE_ENABLE
+        case REPORT_QUEUE_MOUSE:
+            return merge_mouse_report(&pending->report.mouse, &entry->report.mouse);
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Queues a report behind the ones waiting for the host, merging it
+ * into the newest queued report if that is of the same kind and no
+ * transition gets lost.
+ *
+ * @param[in,out] queue report_queue_t of the endpoint
+ * @param[in] entry report_queue_entry_t to queue
+ * @return bool false if the queue is full, the oldest report has to be sent some other way first
+ */
+bool report_queue_push(report_queue_t* queue, const report_queue_entry_t* entry) {
+    if (queue->count > 0) {
+        report_queue_entry_t* newest = &queue->entries[REPORT_QUEUE_INDEX(queue, queue->count - 1)];
+        if (newest->kind == entry->kind && newest->offset == entry->offset && report_queue_merge(queue, newest, entry)) {
+            return true;
+        }
+    }
+
+    if (queue->count == REPORT_QUEUE_SIZE) {
+        queue->overflows++;
+        return false;
+    }
+
+    queue->entries[REPORT_QUEUE_INDEX(queue, queue->count)] = *entry;
+    queue->count++;
+    return true;
+}
+
+/**
+ * @brief Gets the oldest queued report.
+ *
+ * @param[in] queue report_queue_t of the endpoint
+ * @return report_queue_entry_t* oldest report, or NULL if the queue is empty
+ */
+report_queue_entry_t* report_queue_peek(report_queue_t* queue) {
+    return queue->count > 0 ? &queue->entries[queue->head] : NULL;
+}
+
+/**
+ * @brief Removes the oldest queued report once it has been handed to the host.
+ *
+ * @param[in,out] queue report_queue_t of the endpoint
+ */
+void report_queue_pop(report_queue_t* queue) {
+    if (queue->count == 0) {
+        return;
+    }
+    report_queue_sent(queue, &queue->entries[queue->head]);
+    queue->head = REPORT_QUEUE_INDEX(queue, 1);
+    queue->count--;
+}
+
+/**
+ * @brief Records a report handed to the host, to merge later reports against.
+ *
+ * @param[in,out] queue report_queue_t of the endpoint
+ * @param[in] entry report_queue_entry_t that was sent
+ */
+void report_queue_sent(report_queue_t* queue, const report_queue_entry_t* entry) {
+    switch (entry->kind) {
+        case REPORT_QUEUE_KEYBOARD:
+            queue->last_keyboard = entry->report.keyboard;
+            break;
+#ifdef NKRO_ENABLE
+        case REPORT_QUEUE_NKRO:
+            queue->last_nkro = entry->report.nkro;
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Drops all queued reports, e.g. when the host went away.
+ *
+ * @param[out] queue report_queue_t of the endpoint
+ */
+void report_queue_clear(report_queue_t* queue) {
+    memset(queue, 0, sizeof(*queue));
+}
@@ -351,6 +351,58 @@ void clear_keys_from_report(void);
 bool has_mouse_report_changed(report_mouse_t* new_report, report_mouse_t* old_report);
 #endif
 
+bool merge_keyboard_report(report_keyboard_t* pending, const report_keyboard_t* last, const report_keyboard_t* report);
+bool merge_nkro_report(report_nkro_t* pending, const report_nkro_t* last, const report_nkro_t* report);
+#ifdef MOUSE_ENABLE
+bool merge_mouse_report(report_mouse_t* pending, const report_mouse_t* report);
+#endif
+
+#ifndef REPORT_QUEUE_SIZE
+#    define REPORT_QUEUE_SIZE 4
+#endif
+
+typedef enum {
+    REPORT_QUEUE_KEYBOARD,
+    REPORT_QUEUE_NKRO,
+    REPORT_QUEUE_MOUSE,
+    REPORT_QUEUE_OTHER, // sent as is, never merged
+} report_queue_kind_t;
+
+typedef struct {
+    uint8_t kind;   // report_queue_kind_t
+    uint8_t offset; // first byte of the report that is sent
+    uint8_t size;   // number of bytes that are sent
+    union {
+        report_keyboard_t keyboard;
+#ifdef NKRO_ENABLE
+        report_nkro_t nkro;
+#endif
+#ifdef MOUSE_ENABLE
+        report_mouse_t mouse;
+#endif
+    } report;
+} report_queue_entry_t;
+
+/* Reports of one endpoint that are waiting for the host, oldest first. A
+ * report is merged into the newest queued one where no transition gets lost,
+ * and queued behind it otherwise. */
+typedef struct {
+    report_queue_entry_t entries[REPORT_QUEUE_SIZE];
+    uint8_t              head;
+    uint8_t              count;
+    uint8_t              overflows;     // reports that found the queue full
+    report_keyboard_t    last_keyboard; // last keyboard report handed to the host
+#ifdef NKRO_ENABLE
+    report_nkro_t last_nkro; // last NKRO report handed to the host
+#endif
+} report_queue_t;
+
+bool                  report_queue_push(report_queue_t* queue, const report_queue_entry_t* entry);
+report_queue_entry_t* report_queue_peek(report_queue_t* queue);
+void                  report_queue_pop(report_queue_t* queue);
+void                  report_queue_sent(report_queue_t* queue, const report_queue_entry_t* entry);
+void                  report_queue_clear(report_queue_t* queue);
+
 #ifdef __cplusplus
 }
 #endif